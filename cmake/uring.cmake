@@ -0,0 +1,44 @@
+# Copyright (c) 2020, MariaDB Corporation.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; version 2 of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+
+# io_uring for the network IO of the thread pool (sql/threadpool_generic.cc).
+# IORING_FEAT_NODROP is required, the server cannot recover from
+# completions dropped on an overflowing completion queue.
+MACRO(CHECK_URING)
+  IF(CMAKE_SYSTEM_NAME MATCHES "Linux")
+    INCLUDE(CheckSymbolExists)
+    SET(WITH_URING "AUTO" CACHE STRING "Use io_uring in the thread pool: ON, OFF or AUTO")
+    STRING(TOUPPER "${WITH_URING}" WITH_URING_UPPER)
+    IF(WITH_URING_UPPER STREQUAL "ON" OR WITH_URING_UPPER STREQUAL "AUTO")
+      CHECK_INCLUDE_FILES(liburing.h HAVE_LIBURING_H)
+      CHECK_LIBRARY_EXISTS(uring io_uring_queue_init_params "" HAVE_LIBURING)
+      CHECK_SYMBOL_EXISTS(IORING_FEAT_NODROP liburing.h HAVE_IORING_FEAT_NODROP)
+      IF(HAVE_LIBURING_H AND HAVE_LIBURING AND HAVE_IORING_FEAT_NODROP)
+        SET(HAVE_URING TRUE)
+        SET(LIBURING uring)
+        MESSAGE_ONCE(uring "io_uring support in the thread pool enabled")
+      ELSE()
+        UNSET(LIBURING)
+        UNSET(HAVE_URING)
+        MESSAGE_ONCE(uring "io_uring support in the thread pool not enabled")
+        IF(WITH_URING_UPPER STREQUAL "ON")
+          MESSAGE(FATAL_ERROR "Requested WITH_URING=ON however liburing was not found")
+        ENDIF()
+      ENDIF()
+    ELSEIF(NOT WITH_URING_UPPER STREQUAL "OFF")
+      MESSAGE(FATAL_ERROR "Invalid value for WITH_URING. Must be 'ON', 'OFF', or 'AUTO'.")
+    ENDIF()
+  ENDIF()
+ENDMACRO()
@@ -80,6 +80,13 @@ then
   sed '/libzstd1/d' -i debian/control
 fi
 
+# If liburing-dev is not available (before Debian Bullseye and Ubuntu Focal)
+# remove the dependency, the thread pool then uses epoll
+if ! apt-cache madison liburing-dev | grep 'liburing-dev' >/dev/null 2>&1
+then
+  sed '/liburing-dev/d' -i debian/control
+fi
+
 # The binaries should be fully hardened by default. However TokuDB compilation seems to fail on
 # Debian Jessie and older and on Ubuntu Xenial and older with the following error message:
 #   /usr/bin/ld.bfd.real: /tmp/ccOIwjFo.ltrans0.ltrans.o: relocation R_X86_64_PC32 against symbol
@@ -0,0 +1,10 @@
+package My::Suite::Thread_pool_info;
+
+@ISA = qw(My::Suite);
+
+return "No THREAD_POOL_INFO plugin" unless $ENV{THREAD_POOL_INFO_SO};
+
+sub is_default { 1 }
+
+bless { };
+
@@ -0,0 +1,102 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+/*
+  INFORMATION_SCHEMA.THREAD_POOL_QUEUE_WAIT
+
+  Histogram of the time events spent in the queue of each thread group
+  of the thread pool, one row per group and bucket. STOLEN_EVENTS counts
+  the events of the bucket that were taken by workers of other groups,
+  see thread_pool_queue_wait_limit.
+*/
+
+#define MYSQL_SERVER 1
+#include <my_global.h>
+#include <mysql/plugin.h>
+#include <sql_class.h>
+#include <sql_show.h>
+#include <threadpool.h>
+
+static struct st_mysql_information_schema thread_pool_info_plugin=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
+static ST_FIELD_INFO thread_pool_queue_wait_fields[]=
+{
+  {"GROUP_ID", 10, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"WAIT_TIME_US", 20, MYSQL_TYPE_LONGLONG, 0,
+    MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL, 0, 0},
+  {"EVENTS", 20, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"STOLEN_EVENTS", 20, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {NULL, 0, MYSQL_TYPE_NULL, 0, 0, NULL, 0}
+};
+
+
+static int thread_pool_queue_wait_fill(THD *thd, TABLE_LIST *tables, COND *)
+{
+  TABLE *table= tables->table;
+  TP_QUEUE_WAIT_STATS stats;
+
+  /* Groups are numbered from 0, the first missing one ends the list */
+  for (uint group= 0; !tp_get_queue_wait_stats(group, &stats); group++)
+  {
+    ulonglong limit= 10;
+    for (uint i= 0; i < TP_QUEUE_WAIT_BUCKETS; i++, limit*= 10)
+    {
+      table->field[0]->store(group, true);
+      /* The last bucket has no upper bound */
+      if (i < TP_QUEUE_WAIT_BUCKETS - 1)
+      {
+        table->field[1]->set_notnull();
+        table->field[1]->store(limit, true);
+      }
+      else
+        table->field[1]->set_null();
+      table->field[2]->store(stats.events[i], true);
+      table->field[3]->store(stats.stolen_events[i], true);
+      if (schema_table_store_record(thd, table))
+        return 1;
+    }
+  }
+  return 0;
+}
+
+
+static int thread_pool_info_init(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *) p;
+  schema->fields_info= thread_pool_queue_wait_fields;
+  schema->fill_table= thread_pool_queue_wait_fill;
+  return 0;
+}
+
+
+maria_declare_plugin(thread_pool_info)
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &thread_pool_info_plugin,
+  "THREAD_POOL_QUEUE_WAIT",
+  "MariaDB Corporation",
+  "Queue wait time histogram of the thread pool groups",
+  PLUGIN_LICENSE_GPL,
+  thread_pool_info_init,
+  NULL,
+  0x0100,
+  NULL,
+  NULL,
+  "1.0",
+  MariaDB_PLUGIN_MATURITY_EXPERIMENTAL
+}
+maria_declare_plugin_end;
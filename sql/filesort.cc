@@ -83,6 +83,12 @@ void Sort_param::init_for_filesort(uint sortlen, TABLE *table,
   {
     DBUG_ASSERT(addon_buf.length < UINT_MAX32);
     res_length= (uint)addon_buf.length;
+    /* Pack records in the merge files if there is anything to leave out */
+    for (SORT_ADDON_FIELD *addonf= addon_field; addonf->field; addonf++)
+    {
+      if (addonf->null_bit || addonf->length_bytes)
+        using_packed_addons= true;
+    }
   }
   else
   {
@@ -182,6 +188,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   param.init_for_filesort(sortlength(thd, filesort->sortorder, s_length,
                                      &multi_byte_charset),
                           table, max_rows, filesort->sort_positions);
+  param.sort_threads= (uint) thd->variables.sort_threads;
 
   sort->addon_buf=    param.addon_buf;
   sort->addon_field=  param.addon_field;
@@ -310,6 +317,11 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                                 (param.rec_length + sizeof(char*))) /
                                param.rec_length - 1);
     maxbuffer--;				// Offset from 0
+    if (param.using_packed_addons &&
+        !(param.unpack_buff= (uchar*) my_malloc(param.rec_length,
+                                                MYF(MY_WME |
+                                                    MY_THREAD_SPECIFIC))))
+      goto err;
     if (merge_many_buff(&param,
                         (uchar*) sort->get_sort_keys(),
                         buffpek,&maxbuffer,
@@ -336,6 +348,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
 
   err:
   my_free(param.tmp_buffer);
+  my_free(param.unpack_buff);
   if (!subselect || !subselect->is_uncacheable())
   {
     sort->free_sort_buffer();
@@ -895,16 +908,130 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
     1 Error
 */
 
+/**
+  Get the length of an addon field value as stored by Field::pack().
+
+  @param addonf   Addon field descriptor
+  @param from     Start of the packed value
+*/
+
+static inline uint addon_packed_length(const SORT_ADDON_FIELD *addonf,
+                                       const uchar *from)
+{
+  if (!addonf->length_bytes)
+    return addonf->length;
+  /* Length always stored little-endian, see Field_varstring::pack() */
+  return addonf->length_bytes +
+         (addonf->length_bytes == 1 ? (uint) *from : uint2korr(from));
+}
+
+
+/**
+  Pack a sort record with addon fields in place.
+
+  The sort key and the null bits are kept, NULL addon values are left out
+  and CHAR/VARCHAR addon values keep only their packed length. A packed
+  record is never longer than rec_length.
+
+  @return Length of the packed record
+*/
+
+static uint pack_sort_record(Sort_param *param, uchar *rec)
+{
+  uchar *addons= rec + param->sort_length;
+  uchar *to= addons + param->addon_field->offset;
+
+  for (SORT_ADDON_FIELD *addonf= param->addon_field; addonf->field; addonf++)
+  {
+    if (addonf->null_bit && (addons[addonf->null_offset] & addonf->null_bit))
+      continue;
+    uint length= addon_packed_length(addonf, addons + addonf->offset);
+    memmove(to, addons + addonf->offset, length);
+    to+= length;
+  }
+  return (uint) (to - rec);
+}
+
+
+/**
+  Get the length of a sort record packed by pack_sort_record().
+*/
+
+static uint packed_sort_record_length(Sort_param *param, const uchar *rec)
+{
+  const uchar *addons= rec + param->sort_length;
+  uint length= param->sort_length + param->addon_field->offset;
+
+  for (SORT_ADDON_FIELD *addonf= param->addon_field; addonf->field; addonf++)
+  {
+    if (addonf->null_bit && (addons[addonf->null_offset] & addonf->null_bit))
+      continue;
+    length+= addon_packed_length(addonf, rec + length);
+  }
+  return length;
+}
+
+
+/**
+  Expand a record packed by pack_sort_record() to the fixed layout.
+
+  @param param    Sort parameters
+  @param to       Buffer of rec_length bytes, must not overlap with from
+  @param from     Packed record
+
+  @return Length of the packed record
+*/
+
+static uint unpack_sort_record(Sort_param *param, uchar *to,
+                               const uchar *from)
+{
+  uint length= param->sort_length + param->addon_field->offset;
+  uchar *addons= to + param->sort_length;
+
+  memcpy(to, from, length);
+  for (SORT_ADDON_FIELD *addonf= param->addon_field; addonf->field; addonf++)
+  {
+    if (addonf->null_bit && (addons[addonf->null_offset] & addonf->null_bit))
+    {
+#ifdef HAVE_valgrind
+      bzero(addons + addonf->offset, addonf->length);
+#endif
+      continue;
+    }
+    uint field_length= addon_packed_length(addonf, from + length);
+    memcpy(addons + addonf->offset, from + length, field_length);
+#ifdef HAVE_valgrind
+    bzero(addons + addonf->offset + field_length,
+          addonf->length - field_length);
+#endif
+    length+= field_length;
+  }
+  return length;
+}
+
+
+/**
+  Write a sort record to a merge file, packed if the addon fields are.
+  The record is packed in place and can not be used afterwards.
+*/
+
+static inline bool write_sort_record(Sort_param *param, IO_CACHE *to_file,
+                                     uchar *rec)
+{
+  uint length= param->using_packed_addons ? pack_sort_record(param, rec) :
+                                             param->rec_length;
+  return my_b_write(to_file, rec, length);
+}
+
+
 static bool
 write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
            IO_CACHE *buffpek_pointers, IO_CACHE *tempfile)
 {
-  size_t rec_length;
   uchar **end;
   BUFFPEK buffpek;
   DBUG_ENTER("write_keys");
 
-  rec_length= param->rec_length;
   uchar **sort_keys= fs_info->get_sort_keys();
 
   fs_info->sort_buffer(param, count);
@@ -922,7 +1049,7 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
     count=(uint) param->max_rows;               /* purecov: inspected */
   buffpek.count=(ha_rows) count;
   for (end=sort_keys+count ; sort_keys != end ; sort_keys++)
-    if (my_b_write(tempfile, (uchar*) *sort_keys, (uint) rec_length))
+    if (write_sort_record(param, tempfile, *sort_keys))
       goto err;
   if (my_b_write(buffpek_pointers, (uchar*) &buffpek, sizeof(buffpek)))
     goto err;
@@ -1442,6 +1569,7 @@ static bool check_if_pq_applicable(Sort_param *param,
         my_free(filesort_info->addon_field);
         filesort_info->addon_field= NULL;
         param->addon_field= NULL;
+        param->using_packed_addons= false;
 
         param->res_length= param->ref_length;
         param->sort_length+= param->ref_length;
@@ -1533,6 +1661,71 @@ ulong read_to_buffer(IO_CACHE *fromfile, BUFFPEK *buffpek,
 } /* read_to_buffer */
 
 
+/**
+  Read records packed by pack_sort_record() to buffer.
+
+  The packed records are read to the start of the buffer, moved to its
+  end and then expanded from the front, each through param->unpack_buff.
+  As no packed record is longer than rec_length, a record expanded in
+  place never reaches the packed records that follow it.
+
+  @retval  Number of bytes the expanded records take
+           (ulong)-1 if something goes wrong
+*/
+
+static ulong read_packed_to_buffer(Sort_param *param, IO_CACHE *fromfile,
+                                   BUFFPEK *buffpek)
+{
+  uint rec_length= param->rec_length;
+  ulong count= (ulong) MY_MIN((ha_rows) buffpek->max_keys, buffpek->count);
+  size_t length, packed_length;
+  uchar *from, *to, *end;
+
+  if (!count)
+    return 0;
+  length= (size_t) count * rec_length;
+  end= buffpek->base + length;
+  /* The last chunk of the file may be shorter than that */
+  DBUG_ASSERT(fromfile->end_of_file > buffpek->file_pos);
+  set_if_smaller(length, (size_t) (fromfile->end_of_file -
+                                   buffpek->file_pos));
+  if (unlikely(my_b_pread(fromfile, buffpek->base, length,
+                          buffpek->file_pos)))
+    return ((ulong) -1);
+
+  packed_length= 0;
+  for (ulong i= 0; i < count; i++)
+    packed_length+= packed_sort_record_length(param,
+                                              buffpek->base + packed_length);
+  DBUG_ASSERT(packed_length <= length);
+
+  from= end - packed_length;
+  memmove(from, buffpek->base, packed_length);
+  for (to= buffpek->base; to != end; to+= rec_length)
+  {
+    uint rec_packed_length= packed_sort_record_length(param, from);
+    memcpy(param->unpack_buff, from, rec_packed_length);
+    unpack_sort_record(param, to, param->unpack_buff);
+    from+= rec_packed_length;
+  }
+
+  buffpek->key= buffpek->base;
+  buffpek->file_pos+= packed_length;
+  buffpek->count-= count;
+  buffpek->mem_count= count;
+  return (ulong) (end - buffpek->base);
+} /* read_packed_to_buffer */
+
+
+static inline ulong read_sort_records(Sort_param *param, IO_CACHE *fromfile,
+                                      BUFFPEK *buffpek)
+{
+  if (param->using_packed_addons)
+    return read_packed_to_buffer(param, fromfile, buffpek);
+  return read_to_buffer(fromfile, buffpek, param->rec_length);
+}
+
+
 /**
   Put all room used by freed buffer to use in adjacent buffer.
 
@@ -1646,7 +1839,7 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
   {
     buffpek->base= strpos;
     buffpek->max_keys= maxcount;
-    bytes_read= read_to_buffer(from_file, buffpek, rec_length);
+    bytes_read= read_sort_records(param, from_file, buffpek);
     if (unlikely(bytes_read == (ulong) -1))
       goto err;					/* purecov: inspected */
 
@@ -1670,8 +1863,8 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
     buffpek->key+= rec_length;
     if (! --buffpek->mem_count)
     {
-      if (unlikely(!(bytes_read= read_to_buffer(from_file, buffpek,
-                                                rec_length))))
+      if (unlikely(!(bytes_read= read_sort_records(param, from_file,
+                                                   buffpek))))
       {
         (void) queue_remove_top(&queue);
         reuse_freed_buff(&queue, buffpek, rec_length);
@@ -1724,7 +1917,8 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
       */          
       if (!check_dupl_count || dupl_count >= min_dupl_count)
       {
-        if (my_b_write(to_file, src+wr_offset, wr_len))
+        if (flag ? my_b_write(to_file, src+wr_offset, wr_len) :
+                   write_sort_record(param, to_file, src))
           goto err;                           /* purecov: inspected */
       }
       if (cmp)
@@ -1744,8 +1938,8 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
       buffpek->key+= rec_length;
       if (! --buffpek->mem_count)
       {
-        if (unlikely(!(bytes_read= read_to_buffer(from_file, buffpek,
-                                                  rec_length))))
+        if (unlikely(!(bytes_read= read_sort_records(param, from_file,
+                                                     buffpek))))
         {
           (void) queue_remove_top(&queue);
           reuse_freed_buff(&queue, buffpek, rec_length);
@@ -1801,7 +1995,19 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
       buffpek->count= 0;                        /* Don't read more */
     }
     max_rows-= buffpek->mem_count;
-    if (flag == 0)
+    if (flag == 0 && param->using_packed_addons)
+    {
+      uchar *end;
+      src= buffpek->key;
+      for (end= src+buffpek->mem_count*rec_length ;
+           src != end ;
+           src+= rec_length)
+      {
+        if (write_sort_record(param, to_file, src))
+          goto err;                           /* purecov: inspected */
+      }
+    }
+    else if (flag == 0)
     {
       if (my_b_write(to_file, (uchar*) buffpek->key,
                      (size_t)(rec_length*buffpek->mem_count)))
@@ -1827,8 +2033,8 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
     }
   }
   while (likely(!(error=
-                  (bytes_read= read_to_buffer(from_file, buffpek,
-                                              rec_length)) == (ulong) -1)) &&
+                  (bytes_read= read_sort_records(param, from_file,
+                                                 buffpek)) == (ulong) -1)) &&
          bytes_read != 0);
 
 end:
@@ -2104,6 +2310,12 @@ get_addon_fields(TABLE *table, uint sortlength, LEX_STRING *addon_buf)
       addonf->null_bit= 0;
     }
     addonf->length= field->max_packed_col_length(field->pack_length());
+    /* Field_string and Field_varstring pack as length + value */
+    if (field->real_type() == MYSQL_TYPE_STRING ||
+        field->real_type() == MYSQL_TYPE_VARCHAR)
+      addonf->length_bytes= field->field_length > 255 ? 2 : 1;
+    else
+      addonf->length_bytes= 0;
     length+= addonf->length;
     addonf++;
   }
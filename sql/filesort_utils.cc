@@ -18,6 +18,7 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include <algorithm>
 
 
 namespace {
@@ -157,6 +158,120 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
+namespace {
+/**
+  A part of a parallel sort of a sort buffer: either sorting one run of
+  keys in place, or merging two adjacent sorted runs into another array.
+*/
+struct Sort_task
+{
+  qsort2_cmp cmp;
+  size_t *cmp_arg;
+  uchar **src;          // First key of the run(s)
+  uchar **dst;          // Where to merge the runs, or NULL to sort src
+  size_t n1;            // Number of keys in the first run
+  size_t n2;            // Number of keys in the second run
+
+  bool operator()(const uchar *a, const uchar *b) const
+  {
+    return cmp(cmp_arg, &a, &b) < 0;
+  }
+
+  void run()
+  {
+    if (!dst)
+      my_qsort2(src, n1, sizeof(uchar*), cmp, cmp_arg);
+    else
+      std::merge(src, src + n1, src + n1, src + n1 + n2, dst, *this);
+  }
+};
+}
+
+
+static void *sort_task_thread(void *arg)
+{
+  my_thread_init();
+  static_cast<Sort_task*>(arg)->run();
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+  Run sort tasks concurrently. The calling thread runs the first task,
+  as well as the tasks that are too small to be worth a thread and the
+  tasks for which a thread cannot be created.
+*/
+static void run_sort_tasks(Sort_task *tasks, uint n_tasks)
+{
+  pthread_t threads[MAX_SORT_THREADS];
+  bool started[MAX_SORT_THREADS];
+  DBUG_ASSERT(n_tasks <= MAX_SORT_THREADS);
+
+  for (uint i= 1; i < n_tasks; i++)
+    started[i]= tasks[i].n1 + tasks[i].n2 >= MIN_KEYS_PER_SORT_THREAD &&
+                !mysql_thread_create(0, /* Not instrumented */
+                                     &threads[i], NULL,
+                                     sort_task_thread, &tasks[i]);
+  tasks[0].run();
+  for (uint i= 1; i < n_tasks; i++)
+  {
+    if (started[i])
+      pthread_join(threads[i], NULL);
+    else
+      tasks[i].run();
+  }
+}
+
+
+/**
+  Sort the keys in n_threads runs concurrently, and merge the runs
+  pairwise, again concurrently, using buffer as the merge target.
+*/
+static void parallel_sort(uchar **keys, uint count, uint n_threads,
+                          size_t *size, uchar **buffer)
+{
+  Sort_task tasks[MAX_SORT_THREADS];
+  size_t run_start[MAX_SORT_THREADS + 1];
+  const qsort2_cmp cmp= get_ptr_compare(*size);
+
+  for (uint i= 0; i <= n_threads; i++)
+    run_start[i]= (size_t) count * i / n_threads;
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    tasks[i].cmp= cmp;
+    tasks[i].cmp_arg= size;
+    tasks[i].src= keys + run_start[i];
+    tasks[i].dst= NULL;
+    tasks[i].n1= run_start[i + 1] - run_start[i];
+    tasks[i].n2= 0;
+  }
+  run_sort_tasks(tasks, n_threads);
+
+  uchar **src= keys, **dst= buffer;
+  for (uint width= 1; width < n_threads; width*= 2)
+  {
+    uint n_tasks= 0;
+    for (uint i= 0; i < n_threads; i+= 2 * width)
+    {
+      const size_t mid= run_start[MY_MIN(i + width, n_threads)];
+      const size_t end= run_start[MY_MIN(i + 2 * width, n_threads)];
+      Sort_task *task= &tasks[n_tasks++];
+      task->src= src + run_start[i];
+      task->dst= dst + run_start[i];
+      task->n1= mid - run_start[i];
+      task->n2= end - mid;
+    }
+    run_sort_tasks(tasks, n_tasks);
+    std::swap(src, dst);
+  }
+
+  if (src != keys)
+    memcpy(keys, src, count * sizeof(uchar*));
+}
+
+
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
@@ -164,6 +279,17 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
     return;
   uchar **keys= get_sort_keys();
   uchar **buffer= NULL;
+  const uint n_threads= count < MIN_KEYS_FOR_PARALLEL_SORT ? 1 :
+                        MY_MIN(param->sort_threads,
+                               count / MIN_KEYS_PER_SORT_THREAD);
+  if (n_threads > 1 &&
+      (buffer= (uchar**) my_malloc(count*sizeof(char*),
+                                   MYF(MY_THREAD_SPECIFIC))))
+  {
+    parallel_sort(keys, count, n_threads, &size, buffer);
+    my_free(buffer);
+    return;
+  }
   if (radixsort_is_appliccable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(count*sizeof(char*),
                                    MYF(MY_THREAD_SPECIFIC))))
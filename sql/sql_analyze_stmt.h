@@ -162,6 +162,23 @@ class Table_access_tracker
 };
 
 
+/*
+  A class for tracking how much data a hashed join buffer has spilled into
+  its partition files.
+*/
+
+class Jbuf_spill_tracker
+{
+public:
+  Jbuf_spill_tracker() : r_spills(0), r_spilled_bytes(0) {}
+
+  ha_rows r_spills; /* How many times the join buffer was spilled */
+  ulonglong r_spilled_bytes; /* Bytes written into the partition files */
+
+  bool has_spills() { return (r_spills != 0); }
+};
+
+
 class Json_writer;
 
 /*
@@ -4823,6 +4823,21 @@ unsigned long long thd_get_query_id(const MYSQL_THD thd)
   return((unsigned long long)thd->query_id);
 }
 
+/**
+  Get the LIMIT of the current SELECT, for storage engines that size
+  their read-ahead by the number of rows a scan is expected to return.
+
+  @return LIMIT of the current SELECT, or HA_POS_ERROR if there is none
+          or the rows are sorted or grouped before it is applied
+*/
+unsigned long long thd_select_limit(const MYSQL_THD thd)
+{
+  SELECT_LEX *select= thd->lex->current_select;
+  if (!select || select->order_list.elements || select->group_list.elements)
+    return HA_POS_ERROR;
+  return select->master_unit()->select_limit_cnt;
+}
+
 extern "C" const struct charset_info_st *thd_charset(MYSQL_THD thd)
 {
   return(thd->charset());
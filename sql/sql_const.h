@@ -98,6 +98,8 @@
 
 #define MAX_SORT_MEMORY 2048*1024
 #define MIN_SORT_MEMORY 1024
+#define MAX_SORT_THREADS 64
+#define MAX_JOIN_CACHE_HASH_PARTITIONS 128
 
 /* Some portable defines */
 
@@ -1859,6 +1859,8 @@ void Explain_table_access::print_explain_json(Explain_query *query,
     writer->add_member("join_type").add_str(bka_type.join_alg);
     if (bka_type.mrr_type.length())
       writer->add_member("mrr_type").add_str(bka_type.mrr_type);
+    if (bka_type.hash_partitions)
+      writer->add_member("hash_partitions").add_ll(bka_type.hash_partitions);
     if (where_cond)
     {
       writer->add_member("attached_condition");
@@ -1873,6 +1875,12 @@ void Explain_table_access::print_explain_json(Explain_query *query,
         writer->add_double(jbuf_tracker.get_filtered_after_where()*100.0);
       else
         writer->add_null();
+      if (jbuf_spill_tracker.has_spills())
+      {
+        writer->add_member("r_spills").add_ll(jbuf_spill_tracker.r_spills);
+        writer->add_member("r_spilled_bytes").
+          add_ll(jbuf_spill_tracker.r_spilled_bytes);
+      }
     }
   }
 
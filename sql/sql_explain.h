@@ -560,7 +560,7 @@ enum explain_extra_tag
 class EXPLAIN_BKA_TYPE
 {
 public:
-  EXPLAIN_BKA_TYPE() : join_alg(NULL) {}
+  EXPLAIN_BKA_TYPE() : join_alg(NULL), hash_partitions(0) {}
 
   size_t join_buffer_size;
 
@@ -574,6 +574,9 @@ class EXPLAIN_BKA_TYPE
 
   /* Information about MRR usage.  */
   StringBuffer<64> mrr_type;
+
+  /* Number of partition files a full BNLH join buffer is spilled into */
+  uint hash_partitions;
   
   bool is_using_jbuf() { return (join_alg != NULL); }
 };
@@ -836,6 +839,7 @@ class Explain_table_access : public Sql_alloc
   Table_access_tracker tracker;
   Exec_time_tracker op_tracker;
   Table_access_tracker jbuf_tracker;
+  Jbuf_spill_tracker jbuf_spill_tracker;
   
   Explain_rowid_filter *rowid_filter;
 
@@ -883,6 +883,9 @@ size_t JOIN_CACHE::get_max_join_buffer_size(bool optimize_buff_size)
     tables and tries to allocate a buffer for join_tab. In the case of a
     failure the function repeats its attempts with smaller and smaller
     requested sizes of the buffer, but not more than 4 times.
+    The memory needed to spill the join buffers into files is counted
+    against join_buff_space_limit as well, but it is never shrunk: if it
+    does not fit into the limit, the join buffer of join_tab is not spilled.
   
   RETURN VALUE
     0   if the memory has been successfully allocated
@@ -895,6 +898,7 @@ int JOIN_CACHE::alloc_buffer()
   JOIN_CACHE *cache;
   ulonglong curr_buff_space_sz= 0;
   ulonglong curr_min_buff_space_sz= 0;
+  ulonglong spill_space_sz= 0;
   ulonglong join_buff_space_limit=
     join->thd->variables.join_buff_space_limit;
   bool optimize_buff_size= 
@@ -903,6 +907,7 @@ int JOIN_CACHE::alloc_buffer()
   buff= NULL;
   min_buff_size= 0;
   max_buff_size= 0;
+  spill_space_size= 0;
   min_records= 1;
   max_records= (size_t) (partial_join_cardinality <= join_buff_space_limit ?
                  (ulonglong) partial_join_cardinality : join_buff_space_limit);
@@ -918,11 +923,18 @@ int JOIN_CACHE::alloc_buffer()
     {
       curr_min_buff_space_sz+= cache->get_min_join_buffer_size();
       curr_buff_space_sz+= cache->get_join_buffer_size();
+      spill_space_sz+= cache->get_spill_space_size();
     }
   }
   curr_min_buff_space_sz+= min_buff_size;
   curr_buff_space_sz+= buff_size;
 
+  if (curr_min_buff_space_sz + spill_space_sz + get_max_spill_space_size() <=
+      join_buff_space_limit)
+    spill_space_size= get_max_spill_space_size();
+  spill_space_sz+= spill_space_size;
+  join_buff_space_limit-= MY_MIN(spill_space_sz, join_buff_space_limit);
+
   if (curr_min_buff_space_sz > join_buff_space_limit ||
       (curr_buff_space_sz > join_buff_space_limit &&
        (!optimize_buff_size || 
@@ -959,6 +971,7 @@ int JOIN_CACHE::alloc_buffer()
 
 fail:
   buff_size= 0;
+  spill_space_size= 0;
   return 1;
 }
 
@@ -3473,6 +3486,72 @@ void JOIN_TAB_SCAN::close()
 }
 
 
+/* 
+  Initiate an iteration process over the records of a partition file
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    The function positions the partition file set by set_file() at its
+    beginning to read the records of the joined table written into it.
+
+  RETURN VALUE   
+    0            the initiation is a success 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_PART::open()
+{
+  save_or_restore_used_tabs(join_tab, FALSE);
+  join_tab->table->null_row= 0;
+  join_tab->table->status= 0;
+  return MY_TEST(reinit_io_cache(file, READ_CACHE, 0L, 0, 0));
+}
+
+
+/* 
+  Read the next record of the joined table from a partition file
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    The function reads the next record from the partition file into the
+    record buffer of the joined table. The condition pushed to the table
+    has been already checked when the record was written into the file.
+
+  RETURN VALUE   
+    0            the next record exists and has been successfully read 
+    -1           there are no more records in the partition file
+    1            a read error
+*/
+
+int JOIN_TAB_SCAN_PART::next()
+{
+  TABLE *table= join_tab->table;
+  if (my_b_tell(file) >= file->end_of_file)
+    return -1;
+  return MY_TEST(my_b_read(file, table->record[0], table->s->reclength));
+}
+
+
+/*
+  Perform finalizing actions for a scan over a partition file 
+
+  SYNOPSIS
+    close()
+
+  RETURN VALUE   
+    none      
+*/
+
+void JOIN_TAB_SCAN_PART::close()
+{
+  save_or_restore_used_tabs(join_tab, TRUE);
+}
+
+
 /*
   Prepare to iterate over the BNL join cache buffer to look for matches 
 
@@ -3809,10 +3888,504 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
+  if (!(part_scan= new JOIN_TAB_SCAN_PART(join, join_tab)))
+    DBUG_RETURN(1);
+
   DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
 }
 
 
+/*
+  Check whether a BNLH join buffer for a table can be spilled into partitions
+
+  SYNOPSIS
+    bnlh_cache_can_partition()
+      thd      the thread handle
+      tab      the table joined with the records from the join buffer
+      linked   whether the join buffer is linked to a previous join buffer
+      blobs    the number of blob fields stored in the join buffer
+
+  DESCRIPTION
+    A BNLH join buffer is spilled into partition files when it gets full
+    instead of being joined with a new scan of table 'tab' only if
+    join_cache_hash_partitions is not 0 and the records of both join
+    operands can be saved as fixed length images: the buffer is not linked
+    to a previous join buffer, no blob values are stored in it or read from
+    'tab', no rowids of 'tab' are needed and 'tab' is not accessed with
+    range checked for each record.
+    The function is used both by the optimizer to estimate the cost of a
+    hash join and by JOIN_CACHE_BNLH when the join buffer is created.
+
+  RETURN VALUE
+    TRUE    the join buffer can be spilled
+    FALSE   otherwise
+*/
+
+bool bnlh_cache_can_partition(THD *thd, JOIN_TAB *tab, bool linked,
+                              uint blobs)
+{
+  TABLE *table= tab->table;
+  if (!thd->variables.join_cache_hash_partitions ||
+      linked || blobs || tab->keep_current_rowid || tab->use_quick == 2)
+    return FALSE;
+  for (uint i= 0; i < table->s->blob_fields; i++)
+  {
+    if (bitmap_is_set(table->read_set, table->s->blob_field[i]))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
+/*
+  Check whether the BNLH join buffer can be spilled into partition files
+
+  SYNOPSIS
+    can_partition()
+
+  DESCRIPTION
+    The function checks the conditions of bnlh_cache_can_partition() for
+    the join buffer. Spilling is not used by the BKAH join algorithm as
+    it does not scan join_tab.
+
+  RETURN VALUE
+    TRUE    the join buffer can be spilled
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_partition()
+{
+  return get_join_alg() == BNLH_JOIN_ALG &&
+         bnlh_cache_can_partition(join->thd, join_tab, prev_cache != 0,
+                                  blobs);
+}
+
+
+/*
+  Get the size of the memory needed to spill the BNLH join buffer
+
+  SYNOPSIS
+    get_max_spill_space_size()
+
+  DESCRIPTION
+    The function returns the size of the caches of the two sets of
+    join_cache_hash_partitions files used to spill the join buffer and
+    join_tab, or 0 if the join buffer cannot be spilled.
+
+  RETURN VALUE
+    the size of the memory needed to spill the join buffer
+*/
+
+size_t JOIN_CACHE_BNLH::get_max_spill_space_size()
+{
+  if (!can_partition())
+    return 0;
+  return 2*(size_t) join->thd->variables.join_cache_hash_partitions*
+         JOIN_CACHE_PART_BUFF_SIZE;
+}
+
+
+/*
+  Get the number of the partition file for a join key value
+
+  SYNOPSIS
+    get_partition()
+      key    the join key value
+
+  DESCRIPTION
+    The function hashes the key the same way for the records from the
+    join buffer and for the records from join_tab, so that all records
+    that can match each other are spilled into partitions with the same
+    number. The low bits of the hash value are dropped as they are used
+    to pick the entry of the hash table within a partition.
+
+  RETURN VALUE
+    the number of the partition
+*/
+
+uint JOIN_CACHE_BNLH::get_partition(uchar *key)
+{
+  return (uint) ((key_hashnr(ref_key_info, ref_used_key_parts, key) >> 8) %
+                 spill_partitions);
+}
+
+
+/*
+  Open the partition files for spilling the BNLH join buffer
+
+  SYNOPSIS
+    open_partitions()
+
+  DESCRIPTION
+    The function opens two sets of cached temporary files: one for the
+    records from the join buffer and one for the records from join_tab.
+    The number of files in each set and the size of their caches have been
+    accounted for in spill_space_size when the join buffer was allocated.
+    A file is created on disk only when its cache gets full.
+    If any file cannot be opened all of them are closed.
+
+  RETURN VALUE
+    FALSE   the partition files have been opened
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::open_partitions()
+{
+  uint parts= get_partition_count();
+  DBUG_ASSERT(parts);
+  if (!my_multi_malloc(MYF(MY_WME | MY_ZEROFILL),
+                       &outer_parts, 2*parts*sizeof(IO_CACHE),
+                       &outer_ends, parts*sizeof(my_off_t),
+                       NullS))
+    return TRUE;
+  inner_parts= outer_parts+parts;
+  spill_partitions= parts;
+  for (uint i= 0; i < 2*parts; i++)
+  {
+    if (open_cached_file(&outer_parts[i], mysql_tmpdir, TEMP_PREFIX,
+                         JOIN_CACHE_PART_BUFF_SIZE, MYF(MY_WME)))
+    {
+      free_partitions();
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+
+/*
+  Close the partition files of the BNLH join buffer
+*/
+
+void JOIN_CACHE_BNLH::free_partitions()
+{
+  if (outer_parts)
+  {
+    for (uint i= 0; i < 2*spill_partitions; i++)
+      close_cached_file(&outer_parts[i]);
+    my_free(outer_parts);
+    outer_parts= inner_parts= 0;
+    outer_ends= 0;
+  }
+  spill_partitions= 0;
+  spill_error= FALSE;
+}
+
+
+/*
+  Move all records from the BNLH join buffer into the partition files
+
+  SYNOPSIS
+    spill_records()
+
+  DESCRIPTION
+    The function reads each record from the join buffer back into the
+    record buffers, builds its join key and appends the images of all
+    fields of the record described by field_descr to the partition file
+    for this key. The images are taken from the record buffers, so they
+    have the same fixed length for all records. Then the join buffer is
+    emptied for writing and the lengths of the partition files are saved
+    in outer_ends.
+    If a write fails the records stay in the join buffer. The records of
+    the buffer that have been written into the files before the failure
+    are beyond outer_ends, so they are never read back.
+
+  RETURN VALUE
+    FALSE   the records have been spilled
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_records()
+{
+  size_t cnt= records;
+  CACHE_FIELD *copy_end= field_descr+fields;
+  Jbuf_spill_tracker *tracker= join_tab->jbuf_spill_tracker;
+
+  if (!spill_partitions && open_partitions())
+    return TRUE;
+  if (!cnt)
+    return FALSE;
+  tracker->r_spills++;
+  reset(FALSE);
+  for ( ; cnt; cnt--)
+  {
+    get_record();
+    cp_buffer_from_ref(join->thd, join_tab->table, &join_tab->ref);
+    IO_CACHE *file= &outer_parts[get_partition(join_tab->ref.key_buff)];
+    for (CACHE_FIELD *copy= field_descr; copy < copy_end; copy++)
+    {
+      /* Rowids of empty materialized tables have no image */
+      if (!copy->str)
+        continue;
+      if (DBUG_EVALUATE_IF("jbuf_spill_write_error",
+                           tracker->r_spills > 1 && cnt < records, 0) ||
+          my_b_write(file, copy->str, copy->length))
+        return TRUE;
+      tracker->r_spilled_bytes+= copy->length;
+    }
+  }
+  for (uint i= 0; i < spill_partitions; i++)
+    outer_ends[i]= my_b_tell(&outer_parts[i]);
+  reset(TRUE);
+  return FALSE;
+}
+
+
+/*
+  Read the next record spilled into a partition file into record buffers
+
+  SYNOPSIS
+    read_spilled_record()
+      file   the partition file with the records from the join buffer
+      end    the length of the records in the file that can be read
+
+  RETURN VALUE
+    0      the record has been read
+    -1     there are no more records in the partition file
+    1      a read error
+*/
+
+int JOIN_CACHE_BNLH::read_spilled_record(IO_CACHE *file, my_off_t end)
+{
+  CACHE_FIELD *copy_end= field_descr+fields;
+  if (my_b_tell(file) >= end)
+    return -1;
+  for (CACHE_FIELD *copy= field_descr; copy < copy_end; copy++)
+  {
+    if (copy->str && my_b_read(file, copy->str, copy->length))
+      return 1;
+  }
+  return 0;
+}
+
+
+/* 
+  Add a record into the BNLH join buffer spilling the buffer when full
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record adds the record
+    into the join buffer as JOIN_CACHE_HASHED::put_record does. If the
+    buffer gets full and it can be partitioned, the records of the buffer
+    are spilled into the partition files and the buffer is reused for the
+    next records. The records are joined only when join_records is called
+    after the last record has been added. If spilling fails, the full
+    buffer is joined by join_records as well.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  if (!JOIN_CACHE_HASHED::put_record())
+    return FALSE;
+  if (spill_error || !spill_space_size)
+    return TRUE;
+  if (spill_records())
+  {
+    spill_error= TRUE;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Distribute the records of join_tab over the partition files
+
+  SYNOPSIS
+    partition_join_tab_records()
+
+  DESCRIPTION
+    The function scans join_tab once and writes each record that meets
+    the condition pushed to the table into the partition file for the
+    join key built out of the record.
+    If a write fails the function sets spill_error and stops: the
+    partitions of the join buffer are then joined with scans of join_tab.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::partition_join_tab_records()
+{
+  int error;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  TABLE *table= join_tab->table;
+  KEY *keyinfo= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
+  uint reclength= table->s->reclength;
+  Jbuf_spill_tracker *tracker= join_tab->jbuf_spill_tracker;
+
+  if ((rc= join_tab_execution_startup(join_tab)) < 0)
+    return rc;
+
+  if (unlikely((error= join_tab_scan->open())))
+    goto finish;
+
+  while (!(error= join_tab_scan->next()))
+  {
+    if (unlikely(join->thd->check_killed()))
+    {
+      rc= NESTED_LOOP_KILLED;
+      goto finish;
+    }
+    key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+    if (DBUG_EVALUATE_IF("jbuf_spill_inner_write_error", 1, 0) ||
+        my_b_write(&inner_parts[get_partition(key_buff)], table->record[0],
+                   reclength))
+    {
+      spill_error= TRUE;
+      error= -1;
+      break;
+    }
+    tracker->r_spilled_bytes+= reclength;
+  }
+
+finish:
+  if (error)
+    rc= error < 0 ? NESTED_LOOP_OK : NESTED_LOOP_ERROR;
+  join_tab_scan->close();
+  return rc;
+}
+
+
+/*
+  Join the records of each partition of the join buffer and of join_tab
+
+  SYNOPSIS
+    join_partitions()
+
+  DESCRIPTION
+    For each partition the function loads the spilled records from the
+    join buffer back into the buffer and joins them with the records of
+    join_tab from the partition with the same number, which are the only
+    records that can match them. If the records of a partition do not fit
+    into the buffer, the partition of join_tab is read once per refill.
+    Partitions without records from the join buffer are skipped.
+    If join_tab has not been spilled because of spill_error, each partition
+    of the join buffer is joined with scans of join_tab instead.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_partitions()
+{
+  int error= 0;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  JOIN_TAB_SCAN *save_join_tab_scan= join_tab_scan;
+
+  if (!spill_error)
+    join_tab_scan= part_scan;
+  for (uint i= 0; i < spill_partitions; i++)
+  {
+    IO_CACHE *file= &outer_parts[i];
+    if (!outer_ends[i])
+      continue;
+    if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+    {
+      rc= NESTED_LOOP_ERROR;
+      break;
+    }
+    part_scan->set_file(&inner_parts[i]);
+    while (!(error= read_spilled_record(file, outer_ends[i])))
+    {
+      if (!JOIN_CACHE_HASHED::put_record())
+        continue;
+      rc= JOIN_CACHE::join_records(FALSE);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        goto finish;
+    }
+    if (error > 0)
+    {
+      rc= NESTED_LOOP_ERROR;
+      break;
+    }
+    rc= JOIN_CACHE::join_records(FALSE);
+    if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+      break;
+  }
+
+finish:
+  join_tab_scan= save_join_tab_scan;
+  return rc;
+}
+
+
+/*
+  Join records from the BNLH join buffer with records from join_tab
+
+  SYNOPSIS
+    join_records()
+      skip_last    do not look for matches for the last partial join record
+
+  DESCRIPTION
+    If the join buffer has not been spilled this implementation of the
+    virtual function join_records just calls the default implementation.
+    Otherwise the records remaining in the buffer are spilled as well,
+    join_tab is scanned once to spill its records into partitions with
+    the same hash function, and then the records are joined partition
+    by partition. This way join_tab is read once for any number of
+    refills of the join buffer.
+    If the partition files cannot be written, the records that are still
+    in the join buffer and the partitions of the join buffer that have
+    been written are joined with scans of join_tab as without spilling.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_records(bool skip_last)
+{
+  enum_nested_loop_state rc;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_records");
+
+  if (!spill_partitions)
+  {
+    spill_error= FALSE;
+    DBUG_RETURN(JOIN_CACHE::join_records(skip_last));
+  }
+
+  DBUG_ASSERT(!skip_last);
+  if (!spill_error && spill_records())
+    spill_error= TRUE;
+  if (spill_error)
+    rc= JOIN_CACHE::join_records(FALSE);
+  else
+    rc= partition_join_tab_records();
+  if (rc == NESTED_LOOP_OK || rc == NESTED_LOOP_NO_MORE_ROWS)
+    rc= join_partitions();
+  free_partitions();
+  reset(TRUE);
+  DBUG_RETURN(rc);
+}
+
+
+bool JOIN_CACHE_BNLH::save_explain_data(EXPLAIN_BKA_TYPE *explain)
+{
+  if (JOIN_CACHE::save_explain_data(explain))
+    return 1;
+  explain->hash_partitions= get_partition_count();
+  return 0;
+}
+
+
+/*
+  Release the join buffer and the partition files of the BNLH join cache
+*/
+
+void JOIN_CACHE_BNLH::free()
+{
+  free_partitions();
+  JOIN_CACHE::free();
+}
+
+
 /* 
   Calculate the increment of the MRR buffer for a record write       
 
@@ -34,6 +34,9 @@
 #define CACHE_VARSTR2   4        /* long string value (length takes 2 bytes) */
 #define CACHE_ROWID     5        /* ROWID field */
 
+/* Size of the cache of each file a hashed join buffer is spilled into */
+#define JOIN_CACHE_PART_BUFF_SIZE  (IO_SIZE*4)
+
 /*
   The CACHE_FIELD structure used to describe fields of records that
   are written into a join cache buffer from record buffers and backward.
@@ -65,6 +68,9 @@ class JOIN_TAB_SCAN;
 
 class EXPLAIN_BKA_TYPE;
 
+bool bnlh_cache_can_partition(THD *thd, JOIN_TAB *tab, bool linked,
+                              uint blobs);
+
 /*
   JOIN_CACHE is the base class to support the implementations of 
   - Block Nested Loop (BNL) Join Algorithm,
@@ -260,6 +266,11 @@ class JOIN_CACHE :public Sql_alloc
   size_t min_buff_size;
   /* The maximum expected size if the join buffer to be used */
   size_t max_buff_size;
+  /*
+    Size of the memory used for spilling the join buffer into files,
+    0 if the join buffer is not spilled
+  */
+  size_t spill_space_size;
   /* Size of the auxiliary buffer */ 
   size_t aux_buff_size;
 
@@ -540,6 +551,7 @@ class JOIN_CACHE :public Sql_alloc
     join_tab= tab;
     prev_cache= next_cache= 0;
     buff= 0;
+    spill_space_size= 0;
   }
 
   /* 
@@ -555,6 +567,7 @@ class JOIN_CACHE :public Sql_alloc
     next_cache= 0;
     prev_cache= prev;
     buff= 0;
+    spill_space_size= 0;
     if (prev)
       prev->next_cache= this;
   }
@@ -605,6 +618,11 @@ class JOIN_CACHE :public Sql_alloc
   /* Set the size of the cache join buffer to a new value */
   void set_join_buffer_size(size_t sz) { buff_size= sz; }
 
+  /* Get the size of the memory used for spilling the join buffer */
+  size_t get_spill_space_size() { return spill_space_size; }
+  /* Get the size of the memory needed to spill the join buffer */
+  virtual size_t get_max_spill_space_size() { return 0; }
+
   /* Get the minimum possible size of the cache join buffer */
   virtual size_t get_min_join_buffer_size();
   /* Get the maximum possible size of the cache join buffer */ 
@@ -659,7 +677,7 @@ class JOIN_CACHE :public Sql_alloc
   }
      
   /* Join records from the join buffer with records from the next join table */ 
-  enum_nested_loop_state join_records(bool skip_last);
+  virtual enum_nested_loop_state join_records(bool skip_last);
 
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
@@ -668,7 +686,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() {}
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -1086,6 +1104,37 @@ class JOIN_TAB_SCAN: public Sql_alloc
 
 };
 
+
+/*
+  The class JOIN_TAB_SCAN_PART is a companion class for the class
+  JOIN_CACHE_BNLH used when the join buffer has been spilled into
+  partition files. Instead of scanning the joined table again the
+  iterator reads back the records of the table that have been written
+  into the partition file 'file' by the single scan over the table.
+*/
+
+class JOIN_TAB_SCAN_PART: public JOIN_TAB_SCAN
+{
+
+private:
+  /* The partition file with the records of the joined table */
+  IO_CACHE *file;
+
+public:
+
+  JOIN_TAB_SCAN_PART(JOIN *j, JOIN_TAB *tab) :JOIN_TAB_SCAN(j, tab), file(0) {}
+
+  /* Set the partition file to iterate over */
+  void set_file(IO_CACHE *part_file) { file= part_file; }
+
+  int open();
+
+  int next();
+
+  void close();
+
+};
+
 /*
   The class JOIN_CACHE_BNL is used when the BNL join algorithm is
   employed to perform a join operation   
@@ -1147,6 +1196,58 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
 class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 {
 
+private:
+
+  /*
+    The number of partitions the records of the join buffer and of join_tab
+    are spilled into, 0 if the join buffer has not been spilled
+  */
+  uint spill_partitions;
+  /*
+    TRUE if writing into the partition files has failed: the records that
+    have not been spilled are joined with scans of join_tab
+  */
+  bool spill_error;
+  /* The partition files for the records from the join buffer */
+  IO_CACHE *outer_parts;
+  /* The partition files for the records from join_tab */
+  IO_CACHE *inner_parts;
+  /*
+    The length of each partition file in outer_parts up to the last record
+    of the last join buffer that has been spilled completely
+  */
+  my_off_t *outer_ends;
+  /* The iterator over a partition of join_tab used instead of join_tab_scan */
+  JOIN_TAB_SCAN_PART *part_scan;
+
+  /* Check whether the join buffer can be spilled into partition files */
+  bool can_partition();
+
+  /* Get the number of the partition files in each set */
+  uint get_partition_count()
+  {
+    return (uint) (spill_space_size / (2*JOIN_CACHE_PART_BUFF_SIZE));
+  }
+
+  /* Get the number of the partition for a join key value */
+  uint get_partition(uchar *key);
+
+  bool open_partitions();
+
+  void free_partitions();
+
+  /* Move all records from the join buffer into the partition files */
+  bool spill_records();
+
+  /* Read the next record spilled into a partition file into record buffers */
+  int read_spilled_record(IO_CACHE *file, my_off_t end);
+
+  /* Distribute the records of join_tab over the partition files */
+  enum_nested_loop_state partition_join_tab_records();
+
+  /* Join the records of each partition of the join buffer and of join_tab */
+  enum_nested_loop_state join_partitions();
+
 protected:
 
   /* 
@@ -1185,7 +1286,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_partitions(0), spill_error(FALSE),
+      outer_parts(0), inner_parts(0), outer_ends(0), part_scan(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1194,7 +1297,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_partitions(0),
+      spill_error(FALSE), outer_parts(0), inner_parts(0), outer_ends(0),
+      part_scan(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1203,6 +1308,16 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  size_t get_max_spill_space_size();
+
+  bool put_record();
+
+  enum_nested_loop_state join_records(bool skip_last);
+
+  bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
+
+  void free();
+
 };
 
 
@@ -129,6 +129,8 @@ static int join_tab_cmp_straight(const void *dummy, const void* ptr1, const void
 static int join_tab_cmp_embedded_first(const void *emb, const void* ptr1, const void *ptr2);
 C_MODE_END
 static uint cache_record_length(JOIN *join,uint index);
+static bool hash_join_cache_can_partition(JOIN *join, JOIN_TAB *tab,
+                                          uint idx);
 static store_key *get_store_key(THD *thd,
 				KEYUSE *keyuse, table_map used_tables,
 				KEY_PART_INFO *key_part, uchar *key_buff,
@@ -7726,7 +7728,24 @@ best_access_path(JOIN      *join,
     double refills= (1.0 + floor((double) cache_record_length(join,idx) *
                            record_count /
 			   (double) thd->variables.join_buff_size));
-    tmp= COST_MULT(tmp, refills);
+    if (refills > 1 && hash_join_cache_can_partition(join, s, idx))
+    {
+      /*
+        The join buffer is spilled into partition files instead: the table
+        is read once, the partial join records are written and read back
+        once, and the rows of the table are written once and read back once
+        per refill of the buffer with a partition.
+      */
+      double parts= (double) thd->variables.join_cache_hash_partitions;
+      double outer_io= (double) cache_record_length(join,idx) * record_count /
+                       IO_SIZE;
+      double inner_io= rnd_records * s->table->s->reclength / IO_SIZE;
+      tmp= COST_ADD(tmp, COST_ADD(2 * outer_io,
+                                  COST_MULT(inner_io,
+                                            1 + ceil(refills / parts))));
+    }
+    else
+      tmp= COST_MULT(tmp, refills);
     best_time= COST_ADD(tmp,
                         COST_MULT((record_count*join_sel) / TIME_FOR_COMPARE,
                                   rnd_records));
@@ -9710,6 +9729,45 @@ cache_record_length(JOIN *join,uint idx)
 }
 
 
+/*
+  Check whether a hash join buffer for the table 'tab' joined after the
+  partial join order join->positions[0..idx-1] could be spilled into
+  partition files (see bnlh_cache_can_partition()).
+  The join buffer is expected to be linked to the join buffer of the
+  previous table unless join_cache_level is 3. The caches of the partition
+  files must fit into join_buffer_space_limit together with the buffer.
+*/
+
+static bool
+hash_join_cache_can_partition(JOIN *join, JOIN_TAB *tab, uint idx)
+{
+  uint blobs= 0;
+  JOIN_TAB **pos,**end;
+  THD *thd= join->thd;
+  uint cache_level= join->max_allowed_join_cache_level;
+
+  if (2 * thd->variables.join_cache_hash_partitions *
+      JOIN_CACHE_PART_BUFF_SIZE + thd->variables.join_buff_size >
+      thd->variables.join_buff_space_limit)
+    return FALSE;
+
+  if (!(join->allowed_join_cache_types & JOIN_CACHE_INCREMENTAL_BIT) &&
+      cache_level%2 == 0)
+    cache_level--;
+  bool linked= cache_level != 3 && join->positions[idx-1].use_join_buffer;
+
+  for (pos=join->best_ref+join->const_tables,end=join->best_ref+idx ;
+       pos != end ;
+       pos++)
+  {
+    JOIN_TAB *join_tab= *pos;
+    join_tab->get_used_fieldlength();
+    blobs+= join_tab->used_blobs;
+  }
+  return bnlh_cache_can_partition(thd, tab, linked, blobs);
+}
+
+
 /*
   Get the number of different row combinations for subset of partial join
 
@@ -25881,6 +25939,7 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
   // psergey-todo: data for filtering!
   tracker= &eta->tracker;
   jbuf_tracker= &eta->jbuf_tracker;
+  jbuf_spill_tracker= &eta->jbuf_spill_tracker;
 
   /* Enable the table access time tracker only for "ANALYZE stmt" */
   if (thd->lex->analyze_stmt)
@@ -30,12 +30,18 @@ struct TABLE;
 
 #define MERGEBUFF		7
 #define MERGEBUFF2		15
+/* Sort buffers are sorted by sort_threads threads only above this size */
+#define MIN_KEYS_FOR_PARALLEL_SORT	65536
+/* Smaller sort or merge tasks are run by the calling thread */
+#define MIN_KEYS_PER_SORT_THREAD	16384
 
 /*
    The structure SORT_ADDON_FIELD describes a fixed layout
    for field values appended to sorted values in records to be sorted
    in the sort buffer.
-   Only fixed layout is supported now.
+   Only fixed layout is supported in the sort buffer. Records written to
+   the merge files may be packed: NULL values are left out and CHAR and
+   VARCHAR values (length_bytes != 0) are stored without unused bytes.
    Null bit maps for the appended values is placed before the values 
    themselves. Offsets are from the last sorted field, that is from the
    record referefence, which is still last component of sorted records.
@@ -55,6 +61,7 @@ typedef struct st_sort_addon_field
   uint   null_offset;    /* Offset to to null bit from the last sorted field */
   uint   length;         /* Length in the sort buffer */
   uint8  null_bit;       /* Null bit mask for the field */
+  uint8  length_bytes;   /* Length prefix of a packed string, or 0 */
 } SORT_ADDON_FIELD;
 
 struct BUFFPEK_COMPARE_CONTEXT
@@ -83,6 +90,9 @@ class Sort_param {
   uchar *unique_buff;
   bool not_killable;
   char* tmp_buffer;
+  bool using_packed_addons;   // Addon fields are packed in merge files.
+  uchar *unpack_buff;         // rec_length bytes to expand packed records.
+  uint sort_threads;          // Max threads for sorting a sort buffer.
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
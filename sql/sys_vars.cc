@@ -3385,6 +3385,14 @@ static Sys_var_ulonglong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, SIZE_T_MAX), DEFAULT(MAX_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_sort_threads(
+       "sort_threads",
+       "Maximum number of threads that sort a filled sort buffer. The keys "
+       "are sorted in parts concurrently and the parts are merged in "
+       "parallel; 1 sorts on the connection thread only",
+       SESSION_VAR(sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_SORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 export sql_mode_t expand_sql_mode(sql_mode_t sql_mode)
 {
   if (sql_mode & MODE_ANSI)
@@ -3776,6 +3784,15 @@ static Sys_var_uint Sys_threadpool_threadpool_prio_kickup_timer(
   GLOBAL_VAR(threadpool_prio_kickup_timer), CMD_LINE(REQUIRED_ARG),
   VALID_RANGE(0, UINT_MAX), DEFAULT(1000), BLOCK_SIZE(1)
 );
+
+static Sys_var_uint Sys_threadpool_queue_wait_limit(
+ "thread_pool_queue_wait_limit",
+ "The number of milliseconds a statement may wait in the queue of its "
+ "thread group before idle workers of other groups take it. "
+ "0 disables work stealing between thread groups",
+  GLOBAL_VAR(threadpool_queue_wait_limit), CMD_LINE(REQUIRED_ARG),
+  VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1)
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -6029,6 +6046,17 @@ static Sys_var_ulong Sys_join_cache_level(
        SESSION_VAR(join_cache_level), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 8), DEFAULT(2), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_join_cache_hash_partitions(
+       "join_cache_hash_partitions",
+       "Number of disk partitions a full BNLH join buffer and the joined "
+       "table are hashed into, so that the joined table is read only once "
+       "per join instead of once per refill of the buffer; 0 disables "
+       "partitioning. The caches of the partition files count against "
+       "join_buffer_space_limit",
+       SESSION_VAR(join_cache_hash_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, MAX_JOIN_CACHE_HASH_PARTITIONS), DEFAULT(0),
+       BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_mrr_buffer_size(
        "mrr_buffer_size",
        "Size of buffer to use when using MRR with range access",
@@ -28,6 +28,7 @@ extern uint threadpool_stall_limit;  /* time interval in 10 ms units for stall c
 extern uint threadpool_max_threads;  /* Maximum threads in pool */
 extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
 extern uint threadpool_prio_kickup_timer;  /* Time before low prio item gets prio boost */
+extern uint threadpool_queue_wait_limit; /* Queue wait before other groups take an item */
 #ifdef _WIN32
 extern uint threadpool_mode; /* Thread pool implementation , windows or generic */
 #define TP_MODE_WINDOWS 0
@@ -53,6 +54,21 @@ struct TP_STATISTICS
 extern TP_STATISTICS tp_stats;
 
 
+/*
+  Histogram of the time events spent in the queue of a thread group.
+  Bucket i counts the events that waited at most 10^(i+1) microseconds,
+  the last bucket counts all longer waits.
+*/
+#define TP_QUEUE_WAIT_BUCKETS 8
+
+struct TP_QUEUE_WAIT_STATS
+{
+  ulonglong events[TP_QUEUE_WAIT_BUCKETS];
+  /* Events taken from the queue by workers of other thread groups */
+  ulonglong stolen_events[TP_QUEUE_WAIT_BUCKETS];
+};
+
+
 /* Functions to set threadpool parameters */
 extern void tp_set_min_threads(uint val);
 extern void tp_set_max_threads(uint val);
@@ -60,6 +76,7 @@ extern void tp_set_threadpool_size(uint val);
 extern void tp_set_threadpool_stall_limit(uint val);
 extern int tp_get_idle_thread_count();
 extern int tp_get_thread_count();
+extern int tp_get_queue_wait_stats(uint group, TP_QUEUE_WAIT_STATS *stats);
 
 /* Activate threadpool scheduler */
 extern void tp_scheduler(void);
@@ -132,6 +149,7 @@ struct TP_pool
   virtual int set_stall_limit(uint){ return 0; }
   virtual int get_thread_count() { return tp_stats.num_worker_threads; }
   virtual int get_idle_thread_count(){ return 0; }
+  virtual int get_queue_wait_stats(uint, TP_QUEUE_WAIT_STATS *){ return -1; }
 };
 
 #ifdef _WIN32
@@ -157,6 +175,7 @@ struct TP_pool_generic :TP_pool
   virtual int set_pool_size(uint);
   virtual int set_stall_limit(uint);
   virtual int get_idle_thread_count();
+  virtual int get_queue_wait_stats(uint group, TP_QUEUE_WAIT_STATS *stats);
 };
 
 #endif /* HAVE_POOL_OF_THREADS */
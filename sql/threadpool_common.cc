@@ -36,6 +36,7 @@ uint threadpool_max_threads;
 uint threadpool_oversubscribe;
 uint threadpool_mode;
 uint threadpool_prio_kickup_timer;
+uint threadpool_queue_wait_limit;
 
 /* Stats */
 TP_STATISTICS tp_stats;
@@ -437,6 +438,15 @@ int tp_get_thread_count()
   return pool ? pool->get_thread_count() : 0;
 }
 
+/*
+  Copy the queue wait histogram of a thread group.
+  Returns non-zero if there is no such group.
+*/
+int tp_get_queue_wait_stats(uint group, TP_QUEUE_WAIT_STATS *stats)
+{
+  return pool ? pool->get_queue_wait_stats(group, stats) : -1;
+}
+
 void tp_set_min_threads(uint val)
 {
   if (pool)
@@ -50,6 +50,10 @@ typedef int TP_file_handle;
 #include <time.h>
 #ifdef __linux__
 #include <sys/epoll.h>
+#ifdef HAVE_URING
+#include <poll.h>
+#include <liburing.h>
+#endif
 typedef struct epoll_event native_event;
 #elif defined(HAVE_KQUEUE)
 #include <sys/event.h>
@@ -64,16 +68,6 @@ typedef OVERLAPPED_ENTRY native_event;
 #endif
 
 
-static void io_poll_close(TP_file_handle fd)
-{
-#ifdef _WIN32
-  CloseHandle(fd);
-#else
-  close(fd);
-#endif
-}
-
-
 /** Maximum number of native events a listener can read in one go */
 #define MAX_EVENTS 1024
 
@@ -90,9 +84,15 @@ static bool threadpool_started= false;
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_group_mutex;
 static PSI_mutex_key key_timer_mutex;
+#ifdef HAVE_URING
+static PSI_mutex_key key_uring_mutex;
+#endif
 static PSI_mutex_info mutex_list[]=
 {
   { &key_group_mutex, "group_mutex", 0},
+#ifdef HAVE_URING
+  { &key_uring_mutex, "uring_mutex", 0},
+#endif
   { &key_timer_mutex, "timer_mutex", PSI_FLAG_GLOBAL}
 };
 
@@ -152,6 +152,11 @@ struct TP_connection_generic:public TP_connection
   virtual void wait_end();
 
   thread_group_t *thread_group;
+  /*
+    Group of the worker thread handling the current event. It differs from
+    thread_group if the event was taken from the queue of another group.
+  */
+  thread_group_t *worker_group;
   TP_connection_generic *next_in_queue;
   TP_connection_generic **prev_in_queue;
   ulonglong abs_wait_timeout;
@@ -196,6 +201,14 @@ struct MY_ALIGNED(CPU_LEVEL1_DCACHE_LINESIZE) thread_group_t
   int  shutdown_pipe[2];
   bool shutdown;
   bool stalled; 
+  TP_QUEUE_WAIT_STATS queue_wait;
+#ifdef HAVE_URING
+  /* pollfd is the descriptor of this ring, if use_uring is set */
+  bool use_uring;
+  struct io_uring uring;
+  /* Protects the submission queue and reaping of completions */
+  mysql_mutex_t uring_mutex;
+#endif
 };
 
 static thread_group_t *all_groups;
@@ -226,6 +239,7 @@ static void queue_put(thread_group_t *thread_group, TP_connection_generic *conne
 static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt);
 static int  wake_thread(thread_group_t *thread_group);
 static int  wake_or_create_thread(thread_group_t *thread_group);
+static void wake_thief(thread_group_t *thread_group);
 static int  create_worker(thread_group_t *thread_group);
 static void *worker_main(void *param);
 static void check_stall(thread_group_t *thread_group);
@@ -238,7 +252,7 @@ static void print_pool_blocked_message(bool);
  We use native edge-triggered network IO multiplexing facility. 
  This maps to different APIs on different Unixes.
  
- Supported are currently Linux with epoll, Solaris with event ports,
+ Supported are currently Linux with io_uring or epoll, Solaris with event ports,
  OSX and BSD with kevent, Windows with IOCP. All those API's are used with one-shot flags
  (the event is signalled once client has written something into the socket, 
  then socket is removed from the "poll-set" until the  command is finished,
@@ -249,25 +263,33 @@ static void print_pool_blocked_message(bool);
  The API closely resembles all of the above mentioned platform APIs 
  and consists of following functions. 
  
- - io_poll_create()
+ All functions operate on the io poll descriptor of a thread group,
+ thread_group->pollfd.
+
+ - io_poll_create(thread_group_t *thread_group)
  Creates an io_poll descriptor 
- On Linux: epoll_create()
+ On Linux: io_uring_queue_init(), or epoll_create() if io_uring is
+ not available
  
- - io_poll_associate_fd(int poll_fd, TP_file_handle fd, void *data, void *opt)
+ - io_poll_close(thread_group_t *thread_group)
+ Closes the io_poll descriptor
+
+ - io_poll_associate_fd(thread_group_t *thread_group, TP_file_handle fd, void *data, void *opt)
  Associate file descriptor with io poll descriptor 
  On Linux : epoll_ctl(..EPOLL_CTL_ADD))
  
- - io_poll_disassociate_fd(TP_file_handle pollfd, TP_file_handle fd)
+ - io_poll_disassociate_fd(thread_group_t *thread_group, TP_file_handle fd)
   Associate file descriptor with io poll descriptor 
   On Linux: epoll_ctl(..EPOLL_CTL_DEL)
  
  
- - io_poll_start_read(int poll_fd,int fd, void *data, void *opt)
+ - io_poll_start_read(thread_group_t *thread_group, TP_file_handle fd, void *data, void *opt)
  The same as io_poll_associate_fd(), but cannot be used before 
  io_poll_associate_fd() was called.
- On Linux : epoll_ctl(..EPOLL_CTL_MOD)
+ On Linux : epoll_ctl(..EPOLL_CTL_MOD). With io_uring, the request is
+ only queued, and submitted by the next io_poll_wait() or io_poll_flush()
  
- - io_poll_wait (TP_file_handle pollfd, native_event *native_events, int maxevents, 
+ - io_poll_wait(thread_group_t *thread_group, native_event *native_events, int maxevents, 
    int timeout_ms)
  
  wait until one or more descriptors added with io_poll_associate_fd() 
@@ -276,7 +298,13 @@ static void print_pool_blocked_message(bool);
  native_event_get_userdata() function.
 
  
- On Linux: epoll_wait()
+ On Linux: epoll_wait(), or io_uring_enter() that submits queued
+ requests and reaps completions in one go.
+
+ - io_poll_flush(thread_group_t *thread_group)
+ Submit requests queued by io_poll_start_read(). Must be called before
+ a worker stops looking for events, so the connections it re-armed do not
+ wait for the next poll of the group. No-op except with io_uring.
 */
 
 #if defined (__linux__)
@@ -284,36 +312,233 @@ static void print_pool_blocked_message(bool);
 /* Early 2.6 kernel did not have EPOLLRDHUP */
 #define EPOLLRDHUP 0
 #endif
-static TP_file_handle io_poll_create()
+
+#ifdef HAVE_URING
+/*
+  io_uring variant of the Linux implementation.
+
+  Descriptors are armed with IORING_OP_POLL_ADD, which is one-shot like
+  EPOLLONESHOT. Re-arming a connection after a request only fills an entry
+  of the submission queue. The entries are submitted by the next
+  io_poll_wait() of the group, in the same system call that reaps the
+  completions, so a worker that finishes a statement and polls for more
+  work enters the kernel once rather than for epoll_ctl() and epoll_wait().
+
+  The ring is shared by all threads of the group. uring_mutex protects the
+  submission queue and consuming of completions. The listener waits for
+  completions without holding it, and takes it to reap them.
+*/
+
+static bool uring_create(thread_group_t *thread_group)
+{
+  static bool warned= false;
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int ret= io_uring_queue_init_params(MAX_EVENTS, &thread_group->uring,
+                                      &params);
+  if (ret)
+  {
+    /* Kernel too old, io_uring disabled, or RLIMIT_MEMLOCK too low */
+    if (!warned)
+    {
+      warned= true;
+      sql_print_warning("Threadpool: io_uring_queue_init() failed, "
+                        "errno=%d, using epoll", -ret);
+    }
+    return false;
+  }
+  if (!(params.features & IORING_FEAT_NODROP))
+  {
+    /*
+      Every connection of the group may have a completion pending, far more
+      than the completion queue holds. Kernels before 5.5 drop completions
+      on overflow, and the connections they belong to would never be woken.
+    */
+    io_uring_queue_exit(&thread_group->uring);
+    if (!warned)
+    {
+      warned= true;
+      sql_print_warning("Threadpool: io_uring lacks IORING_FEAT_NODROP, "
+                        "using epoll");
+    }
+    return false;
+  }
+  mysql_mutex_init(key_uring_mutex, &thread_group->uring_mutex, NULL);
+  thread_group->use_uring= true;
+  return true;
+}
+
+
+static void uring_close(thread_group_t *thread_group)
+{
+  io_uring_queue_exit(&thread_group->uring);
+  mysql_mutex_destroy(&thread_group->uring_mutex);
+  thread_group->use_uring= false;
+}
+
+
+static int uring_start_read(thread_group_t *thread_group, TP_file_handle fd,
+                            void *data, bool submit)
+{
+  struct io_uring *ring= &thread_group->uring;
+  struct io_uring_sqe *sqe;
+
+  mysql_mutex_lock(&thread_group->uring_mutex);
+  if (!(sqe= io_uring_get_sqe(ring)))
+  {
+    /* Submission queue is full, make room */
+    io_uring_submit(ring);
+    sqe= io_uring_get_sqe(ring);
+  }
+  if (sqe)
+  {
+    io_uring_prep_poll_add(sqe, fd, POLLIN|POLLERR|POLLRDHUP);
+    io_uring_sqe_set_data(sqe, data);
+    if (submit)
+      io_uring_submit(ring);
+  }
+  mysql_mutex_unlock(&thread_group->uring_mutex);
+  return sqe ? 0 : -1;
+}
+
+
+/*
+  Submit queued requests and take up to maxevents completions.
+  With timeout_ms=-1, wait until there is at least one completion.
+*/
+
+static int uring_wait(thread_group_t *thread_group,
+                      native_event *native_events, int maxevents,
+                      int timeout_ms)
+{
+  struct io_uring *ring= &thread_group->uring;
+  struct io_uring_cqe *cqes[MAX_EVENTS];
+  struct io_uring_cqe *cqe;
+  unsigned cnt;
+  int n;
+  int ret;
+
+  DBUG_ASSERT(timeout_ms == 0 || timeout_ms == -1);
+  maxevents= MY_MIN(maxevents, MAX_EVENTS);
+  for (;;)
+  {
+    mysql_mutex_lock(&thread_group->uring_mutex);
+    io_uring_submit(ring);
+    cnt= io_uring_peek_batch_cqe(ring, cqes, (unsigned) maxevents);
+    n= 0;
+    for (unsigned i= 0; i < cnt; i++)
+    {
+      void *data= io_uring_cqe_get_data(cqes[i]);
+      if (cqes[i]->res < 0)
+      {
+        /*
+          The poll failed, the descriptor is not readable. Poll again, unless
+          it was cancelled or the descriptor is invalid.
+        */
+        int err= -cqes[i]->res;
+        if (err == ECANCELED)
+          continue;
+        sql_print_warning("Threadpool: io_uring poll failed, errno=%d", err);
+        if (err == EBADF || err == EINVAL)
+          continue;
+        struct io_uring_sqe *sqe= io_uring_get_sqe(ring);
+        if (!sqe)
+          continue;
+        io_uring_prep_poll_add(sqe, data ?
+                               ((TP_connection_generic *) data)->fd :
+                               thread_group->shutdown_pipe[0],
+                               POLLIN|POLLERR|POLLRDHUP);
+        io_uring_sqe_set_data(sqe, data);
+        continue;
+      }
+      native_events[n].events= (uint32_t) cqes[i]->res;
+      native_events[n].data.ptr= data;
+      n++;
+    }
+    io_uring_cq_advance(ring, cnt);
+    mysql_mutex_unlock(&thread_group->uring_mutex);
+
+    if (n || !timeout_ms)
+      return n;
+
+    /*
+      Only wait here, completions are consumed under the mutex above,
+      since a worker of the group may reap them concurrently.
+    */
+    do
+    {
+      ret= io_uring_wait_cqe(ring, &cqe);
+    }
+    while (ret == -EINTR);
+    if (ret < 0)
+      return -1;
+  }
+}
+
+
+static void uring_flush(thread_group_t *thread_group)
+{
+  struct io_uring *ring= &thread_group->uring;
+
+  /* The submission queue tail is only consistent under the mutex */
+  mysql_mutex_lock(&thread_group->uring_mutex);
+  if (io_uring_sq_ready(ring))
+    io_uring_submit(ring);
+  mysql_mutex_unlock(&thread_group->uring_mutex);
+}
+#endif /* HAVE_URING */
+
+
+static TP_file_handle io_poll_create(thread_group_t *thread_group)
 {
+#ifdef HAVE_URING
+  if (uring_create(thread_group))
+    return thread_group->uring.ring_fd;
+#endif
   return epoll_create(1);
 }
 
 
-int io_poll_associate_fd(TP_file_handle pollfd, TP_file_handle fd, void *data, void*)
+int io_poll_associate_fd(thread_group_t *thread_group, TP_file_handle fd, void *data, void*)
 {
+#ifdef HAVE_URING
+  if (thread_group->use_uring)
+    return uring_start_read(thread_group, fd, data, true);
+#endif
   struct epoll_event ev;
   ev.data.u64= 0; /* Keep valgrind happy */
   ev.data.ptr= data;
   ev.events=  EPOLLIN|EPOLLET|EPOLLERR|EPOLLRDHUP|EPOLLONESHOT;
-  return epoll_ctl(pollfd, EPOLL_CTL_ADD,  fd, &ev);
+  return epoll_ctl(thread_group->pollfd, EPOLL_CTL_ADD,  fd, &ev);
 }
 
 
 
-int io_poll_start_read(TP_file_handle pollfd, TP_file_handle fd, void *data, void *)
+int io_poll_start_read(thread_group_t *thread_group, TP_file_handle fd, void *data, void *)
 {
+#ifdef HAVE_URING
+  if (thread_group->use_uring)
+    return uring_start_read(thread_group, fd, data, false);
+#endif
   struct epoll_event ev;
   ev.data.u64= 0; /* Keep valgrind happy */
   ev.data.ptr= data;
   ev.events=  EPOLLIN|EPOLLET|EPOLLERR|EPOLLRDHUP|EPOLLONESHOT;
-  return epoll_ctl(pollfd, EPOLL_CTL_MOD,  fd, &ev); 
+  return epoll_ctl(thread_group->pollfd, EPOLL_CTL_MOD,  fd, &ev); 
 }
 
-int io_poll_disassociate_fd(TP_file_handle pollfd, TP_file_handle fd)
+int io_poll_disassociate_fd(thread_group_t *thread_group, TP_file_handle fd)
 {
+#ifdef HAVE_URING
+  /*
+    Nothing to remove, the descriptor is only disassociated while its
+    connection is being handled, and the one-shot poll has completed.
+  */
+  if (thread_group->use_uring)
+    return 0;
+#endif
   struct epoll_event ev;
-  return epoll_ctl(pollfd, EPOLL_CTL_DEL,  fd, &ev);
+  return epoll_ctl(thread_group->pollfd, EPOLL_CTL_DEL,  fd, &ev);
 }
 
 
@@ -322,13 +547,17 @@ int io_poll_disassociate_fd(TP_file_handle pollfd, TP_file_handle fd)
  NOTE - in case of EINTR, it restarts with original timeout. Since we use
  either infinite or 0 timeouts, this is not critical
 */
-int io_poll_wait(TP_file_handle pollfd, native_event *native_events, int maxevents, 
+int io_poll_wait(thread_group_t *thread_group, native_event *native_events, int maxevents, 
               int timeout_ms)
 {
   int ret;
+#ifdef HAVE_URING
+  if (thread_group->use_uring)
+    return uring_wait(thread_group, native_events, maxevents, timeout_ms);
+#endif
   do 
   {
-    ret = epoll_wait(pollfd, native_events, maxevents, timeout_ms);
+    ret = epoll_wait(thread_group->pollfd, native_events, maxevents, timeout_ms);
   }
   while(ret == -1 && errno == EINTR);
   return ret;
@@ -355,38 +584,38 @@ static void *native_event_get_userdata(native_event *event)
 #endif
 
 
-TP_file_handle io_poll_create()
+TP_file_handle io_poll_create(thread_group_t *)
 {
   return kqueue();
 }
 
-int io_poll_start_read(TP_file_handle pollfd, TP_file_handle fd, void *data,void *)
+int io_poll_start_read(thread_group_t *thread_group, TP_file_handle fd, void *data,void *)
 {
   struct kevent ke;
   MY_EV_SET(&ke, fd, EVFILT_READ, EV_ADD|EV_ONESHOT, 
          0, 0, data);
-  return kevent(pollfd, &ke, 1, 0, 0, 0); 
+  return kevent(thread_group->pollfd, &ke, 1, 0, 0, 0); 
 }
 
 
-int io_poll_associate_fd(TP_file_handle pollfd, TP_file_handle fd, void *data,void *)
+int io_poll_associate_fd(thread_group_t *thread_group, TP_file_handle fd, void *data,void *)
 {
   struct kevent ke;
   MY_EV_SET(&ke, fd, EVFILT_READ, EV_ADD|EV_ONESHOT, 
          0, 0, data);
-  return io_poll_start_read(pollfd,fd, data, 0); 
+  return io_poll_start_read(thread_group,fd, data, 0); 
 }
 
 
-int io_poll_disassociate_fd(TP_file_handle pollfd, TP_file_handle fd)
+int io_poll_disassociate_fd(thread_group_t *thread_group, TP_file_handle fd)
 {
   struct kevent ke;
   MY_EV_SET(&ke,fd, EVFILT_READ, EV_DELETE, 0, 0, 0);
-  return kevent(pollfd, &ke, 1, 0, 0, 0);
+  return kevent(thread_group->pollfd, &ke, 1, 0, 0, 0);
 }
 
 
-int io_poll_wait(TP_file_handle pollfd, struct kevent *events, int maxevents, int timeout_ms)
+int io_poll_wait(thread_group_t *thread_group, struct kevent *events, int maxevents, int timeout_ms)
 {
   struct timespec ts;
   int ret;
@@ -397,7 +626,7 @@ int io_poll_wait(TP_file_handle pollfd, struct kevent *events, int maxevents, in
   }
   do
   {
-    ret= kevent(pollfd, 0, 0, events, maxevents, 
+    ret= kevent(thread_group->pollfd, 0, 0, events, maxevents, 
                (timeout_ms >= 0)?&ts:NULL);
   }
   while (ret == -1 && errno == EINTR);
@@ -411,27 +640,27 @@ static void* native_event_get_userdata(native_event *event)
 
 #elif defined (__sun)
 
-static TP_file_handle io_poll_create()
+static TP_file_handle io_poll_create(thread_group_t *)
 {
   return port_create();
 }
 
-int io_poll_start_read(TP_file_handle pollfd, TP_file_handle fd, void *data, void *)
+int io_poll_start_read(thread_group_t *thread_group, TP_file_handle fd, void *data, void *)
 {
-  return port_associate(pollfd, PORT_SOURCE_FD, fd, POLLIN, data);
+  return port_associate(thread_group->pollfd, PORT_SOURCE_FD, fd, POLLIN, data);
 }
 
-static int io_poll_associate_fd(TP_file_handle pollfd, TP_file_handle fd, void *data, void *)
+static int io_poll_associate_fd(thread_group_t *thread_group, TP_file_handle fd, void *data, void *)
 {
-  return io_poll_start_read(pollfd, fd, data, 0);
+  return io_poll_start_read(thread_group, fd, data, 0);
 }
 
-int io_poll_disassociate_fd(TP_file_handle pollfd, TP_file_handle fd)
+int io_poll_disassociate_fd(thread_group_t *thread_group, TP_file_handle fd)
 {
-  return port_dissociate(pollfd, PORT_SOURCE_FD, fd);
+  return port_dissociate(thread_group->pollfd, PORT_SOURCE_FD, fd);
 }
 
-int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents, int timeout_ms)
+int io_poll_wait(thread_group_t *thread_group, native_event *events, int maxevents, int timeout_ms)
 {
   struct timespec ts;
   int ret;
@@ -443,7 +672,7 @@ int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents, int
   }
   do
   {
-    ret= port_getn(pollfd, events, maxevents, &nget,
+    ret= port_getn(thread_group->pollfd, events, maxevents, &nget,
             (timeout_ms >= 0)?&ts:NULL);
   }
   while (ret == -1 && errno == EINTR);
@@ -459,13 +688,13 @@ static void* native_event_get_userdata(native_event *event)
 #elif defined(HAVE_IOCP)
 
 
-static TP_file_handle io_poll_create()
+static TP_file_handle io_poll_create(thread_group_t *)
 {
   return CreateIoCompletionPort(INVALID_HANDLE_VALUE, 0, 0, 0);
 }
 
 
-int io_poll_start_read(TP_file_handle pollfd, TP_file_handle fd, void *, void *opt)
+int io_poll_start_read(thread_group_t *thread_group, TP_file_handle fd, void *, void *opt)
 {
   static char c;
   TP_connection_generic *con= (TP_connection_generic *)opt;
@@ -493,26 +722,26 @@ int io_poll_start_read(TP_file_handle pollfd, TP_file_handle fd, void *, void *o
 }
 
 
-static int io_poll_associate_fd(TP_file_handle pollfd, TP_file_handle fd, void *data, void *opt)
+static int io_poll_associate_fd(thread_group_t *thread_group, TP_file_handle fd, void *data, void *opt)
 {
-  HANDLE h= CreateIoCompletionPort(fd, pollfd, (ULONG_PTR)data, 0);
+  HANDLE h= CreateIoCompletionPort(fd, thread_group->pollfd, (ULONG_PTR)data, 0);
   if (!h) 
     return -1;
-  return io_poll_start_read(pollfd,fd, 0, opt); 
+  return io_poll_start_read(thread_group,fd, 0, opt); 
 }
 
 
-int io_poll_disassociate_fd(TP_file_handle pollfd, TP_file_handle fd)
+int io_poll_disassociate_fd(thread_group_t *thread_group, TP_file_handle fd)
 {
   /* Not possible to unbind/rebind file descriptor in IOCP. */
   return 0;
 }
 
 
-int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents, int timeout_ms)
+int io_poll_wait(thread_group_t *thread_group, native_event *events, int maxevents, int timeout_ms)
 {
   ULONG n;
-  BOOL ok = GetQueuedCompletionStatusEx(pollfd, events, 
+  BOOL ok = GetQueuedCompletionStatusEx(thread_group->pollfd, events, 
      maxevents, &n, timeout_ms, FALSE);
  
   return ok ? (int)n : -1;
@@ -526,22 +755,113 @@ static void* native_event_get_userdata(native_event *event)
 #endif
 
 
+static void io_poll_close(thread_group_t *thread_group)
+{
+#ifdef _WIN32
+  CloseHandle(thread_group->pollfd);
+#else
+#ifdef HAVE_URING
+  if (thread_group->use_uring)
+  {
+    uring_close(thread_group);
+    return;
+  }
+#endif
+  close(thread_group->pollfd);
+#endif
+}
+
+
+static void io_poll_flush(thread_group_t *thread_group)
+{
+#ifdef HAVE_URING
+  if (thread_group->use_uring)
+    uring_flush(thread_group);
+#endif
+}
+
+
+/*
+  Move low priority connections that waited longer than
+  thread_pool_prio_kickup_timer to the high priority queue.
+*/
+
+static void queue_kickup(thread_group_t *thread_group, ulonglong now)
+{
+  TP_connection_generic *c;
+  for (;;)
+  {
+    c= thread_group->queues[TP_PRIORITY_LOW].front();
+    if (c && now > c->dequeue_time + 1000ULL * threadpool_prio_kickup_timer)
+    {
+      thread_group->queues[TP_PRIORITY_LOW].remove(c);
+      thread_group->queues[TP_PRIORITY_HIGH].push_back(c);
+    }
+    else
+      break;
+  }
+}
+
+
+/* Check whether an element waits in a workqueue longer than allowed */
+
+static bool queue_wait_exceeded(thread_group_t *thread_group, ulonglong now)
+{
+  for (int i=0; i < NQUEUES; i++)
+  {
+    TP_connection_generic *c= thread_group->queues[i].front();
+    if (c && now > c->dequeue_time + 1000ULL * threadpool_queue_wait_limit)
+      return true;
+  }
+  return false;
+}
+
+
 /* Dequeue element from a workqueue */
 
-static TP_connection_generic *queue_get(thread_group_t *thread_group)
+static TP_connection_generic *queue_get(thread_group_t *thread_group,
+                                        bool stolen= false)
 {
   DBUG_ENTER("queue_get");
   thread_group->queue_event_count++;
   TP_connection_generic *c;
+  ulonglong now= microsecond_interval_timer();
+
+  /* Low priority elements are boosted as soon as they waited long enough */
+  queue_kickup(thread_group, now);
   for (int i=0; i < NQUEUES;i++)
   {
     c= thread_group->queues[i].pop_front();
     if (c)
+    {
+      /* Account the wait in the histogram */
+      ulonglong wait= now > c->dequeue_time ? now - c->dequeue_time : 0;
+      ulonglong limit= 10;
+      int bucket= 0;
+      for (; bucket < TP_QUEUE_WAIT_BUCKETS - 1 && wait > limit; bucket++)
+        limit*= 10;
+      thread_group->queue_wait.events[bucket]++;
+      if (stolen)
+        thread_group->queue_wait.stolen_events[bucket]++;
       DBUG_RETURN(c);
+    }
   }
   DBUG_RETURN(0);  
 }
 
+/*
+  Debug: workers of the first group leave the events of its queue to the
+  workers of other groups, which steal them. This lets the first group
+  lag behind.
+*/
+
+static bool debug_group_lags(thread_group_t *thread_group)
+{
+  DBUG_EXECUTE_IF("threadpool_lagging_group",
+                  return thread_group == all_groups;);
+  return false;
+}
+
 static bool is_queue_empty(thread_group_t *thread_group)
 {
   for (int i=0; i < NQUEUES; i++)
@@ -563,7 +883,7 @@ static void queue_init(thread_group_t *thread_group)
 
 static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt)
 {
-  ulonglong now= pool_timer.current_microtime;
+  ulonglong now= microsecond_interval_timer();
   for(int i=0; i < cnt; i++)
   {
     TP_connection_generic *c = (TP_connection_generic *)native_event_get_userdata(&ev[i]);
@@ -677,18 +997,7 @@ void check_stall(thread_group_t *thread_group)
    Bump priority for the low priority connections that spent too much
    time in low prio queue.
   */
-  TP_connection_generic *c;
-  for (;;)
-  {
-    c= thread_group->queues[TP_PRIORITY_LOW].front();
-    if (c && pool_timer.current_microtime - c->dequeue_time > 1000ULL * threadpool_prio_kickup_timer)
-    {
-      thread_group->queues[TP_PRIORITY_LOW].remove(c);
-      thread_group->queues[TP_PRIORITY_HIGH].push_back(c);
-    }
-    else
-      break;
-  }
+  queue_kickup(thread_group, pool_timer.current_microtime);
 
   /*
     Check if listener is present. If not,  check whether any IO 
@@ -740,8 +1049,12 @@ void check_stall(thread_group_t *thread_group)
   
   /* Reset queue event count */
   thread_group->queue_event_count= 0;
-  
+
+  bool lagging= threadpool_queue_wait_limit &&
+    queue_wait_exceeded(thread_group, pool_timer.current_microtime);
   mysql_mutex_unlock(&thread_group->mutex);
+  if (lagging)
+    wake_thief(thread_group);
 }
 
 
@@ -789,7 +1102,7 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     if (thread_group->shutdown)
       break;
   
-    cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, -1);
+    cnt = io_poll_wait(thread_group, ev, MAX_EVENTS, -1);
     
     if (cnt <=0)
     {
@@ -845,13 +1158,12 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
      handle the queue. If this does  not happen, timer thread will detect stall
      and wake a worker.
      
-     NOTE: Currently nothing is done to detect or prevent long queuing times. 
-     A solution for the future would be to give up "one active thread per 
-     group" principle, if events stay  in the queue for too long, and just wake 
-     more workers.
+     If events stay in the queue for longer than thread_pool_queue_wait_limit,
+     an idle worker of another group is woken to take them, see steal_event().
     */
     
-    bool listener_picks_event=is_queue_empty(thread_group);
+    bool listener_picks_event=is_queue_empty(thread_group) &&
+                              !debug_group_lags(thread_group);
     queue_put(thread_group, ev, cnt);
     if (listener_picks_event)
     {
@@ -886,7 +1198,11 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
         }
       }
     }
+    bool lagging= threadpool_queue_wait_limit &&
+      queue_wait_exceeded(thread_group, microsecond_interval_timer());
     mysql_mutex_unlock(&thread_group->mutex);
+    if (lagging)
+      wake_thief(thread_group);
   }
 
   DBUG_RETURN(retval);
@@ -1052,7 +1368,7 @@ void thread_group_destroy(thread_group_t *thread_group)
   mysql_mutex_destroy(&thread_group->mutex);
   if (thread_group->pollfd != INVALID_HANDLE_VALUE)
   {
-    io_poll_close(thread_group->pollfd);
+    io_poll_close(thread_group);
     thread_group->pollfd= INVALID_HANDLE_VALUE;
   }
 #ifndef HAVE_IOCP
@@ -1101,7 +1417,7 @@ static int wake_listener(thread_group_t *thread_group)
   }
 
   /* Wake listener */
-  if (io_poll_associate_fd(thread_group->pollfd,
+  if (io_poll_associate_fd(thread_group,
     thread_group->shutdown_pipe[0], NULL, NULL))
   {
     return -1;
@@ -1162,7 +1478,7 @@ static void queue_put(thread_group_t *thread_group, TP_connection_generic *conne
 {
   DBUG_ENTER("queue_put");
 
-  connection->dequeue_time= pool_timer.current_microtime;
+  connection->dequeue_time= microsecond_interval_timer();
   thread_group->queues[connection->priority].push_back(connection);
 
   if (thread_group->active_thread_count == 0)
@@ -1184,6 +1500,81 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Take an event that waits too long in the queue of another group.
+
+  Work stealing lets idle workers of one group help a group whose queue
+  is not drained within thread_pool_queue_wait_limit milliseconds, e.g.
+  because its connections run long queries. The connection stays in its
+  own group, only this single event is handled by the calling worker.
+
+  Group mutexes are only tried, never waited for, and the caller must not
+  hold the mutex of its own group, so that two stealing workers never
+  deadlock.
+
+  @param thread_group - group of the calling worker
+  @return connection with pending event, or NULL
+*/
+
+static TP_connection_generic *steal_event(thread_group_t *thread_group)
+{
+  uint count= group_count;
+  uint own= (uint) (thread_group - all_groups);
+  ulonglong now= microsecond_interval_timer();
+
+  if (!threadpool_queue_wait_limit || shutdown_group_count)
+    return NULL;
+
+  for (uint i= 1; i <= count; i++)
+  {
+    thread_group_t *victim= &all_groups[(own + i) % count];
+    TP_connection_generic *c= NULL;
+
+    /* Dirty read, a queue that just got an element is checked next time */
+    if (victim == thread_group || is_queue_empty(victim))
+      continue;
+    if (mysql_mutex_trylock(&victim->mutex))
+      continue;
+    if (!victim->shutdown && queue_wait_exceeded(victim, now))
+      c= queue_get(victim, true);
+    mysql_mutex_unlock(&victim->mutex);
+    if (c)
+      return c;
+  }
+  return NULL;
+}
+
+
+/**
+  Wake an idle worker of another group to steal from thread_group.
+
+  Called without the mutex of thread_group, when an event in its queue
+  has waited longer than thread_pool_queue_wait_limit.
+*/
+
+static void wake_thief(thread_group_t *thread_group)
+{
+  uint count= group_count;
+  uint own= (uint) (thread_group - all_groups);
+
+  for (uint i= 1; i <= count; i++)
+  {
+    thread_group_t *thief= &all_groups[(own + i) % count];
+    bool woken;
+
+    if (thief == thread_group || thief->waiting_threads.is_empty())
+      continue;
+    if (mysql_mutex_trylock(&thief->mutex))
+      continue;
+    woken= !thief->shutdown && !too_many_threads(thief) &&
+           is_queue_empty(thief) && !wake_thread(thief);
+    mysql_mutex_unlock(&thief->mutex);
+    if (woken)
+      return;
+  }
+}
+
+
 /**
   Retrieve a connection with pending event.
   
@@ -1220,7 +1611,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
      break;
 
     /* Check if queue is not empty */
-    if (!oversubscribed)
+    if (!oversubscribed && !debug_group_lags(thread_group))
     {
       connection = queue_get(thread_group);
       if(connection)
@@ -1253,16 +1644,36 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     {
 
       native_event ev[MAX_EVENTS];
-      int cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, 0);
+      int cnt = io_poll_wait(thread_group, ev, MAX_EVENTS, 0);
       if (cnt > 0)
       {
         queue_put(thread_group, ev, cnt);
-        connection= queue_get(thread_group);
-        break;
+        if (!debug_group_lags(thread_group))
+        {
+          connection= queue_get(thread_group);
+          break;
+        }
+      }
+
+      /* Nothing to do in this group, help a group that lags behind */
+      if (threadpool_queue_wait_limit)
+      {
+        mysql_mutex_unlock(&thread_group->mutex);
+        connection= steal_event(thread_group);
+        mysql_mutex_lock(&thread_group->mutex);
+        if (connection)
+          break;
+        /* Own work may have been queued while the mutex was released */
+        if ((!is_queue_empty(thread_group) &&
+             !debug_group_lags(thread_group)) || thread_group->shutdown)
+          continue;
       }
     }
 
 
+    /* Connections re-armed by this thread must not wait while it sleeps */
+    io_poll_flush(thread_group);
+
     /* And now, finally sleep */ 
     current_thread->woken = false; /* wake() sets this to true */
 
@@ -1300,6 +1711,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
   }
 
   thread_group->stalled= false;
+  io_poll_flush(thread_group);
   mysql_mutex_unlock(&thread_group->mutex);
  
   DBUG_RETURN(connection);
@@ -1389,7 +1801,7 @@ void TP_connection_generic::wait_begin(int type)
   DBUG_ASSERT(!waiting);
   waiting++;
   if (waiting == 1)
-    ::wait_begin(thread_group);
+    ::wait_begin(worker_group);
   DBUG_VOID_RETURN;
 }
 
@@ -1404,7 +1816,7 @@ void TP_connection_generic::wait_end()
   DBUG_ASSERT(waiting);
   waiting--;
   if (waiting == 0)
-    ::wait_end(thread_group);
+    ::wait_end(worker_group);
   DBUG_VOID_RETURN;
 }
 
@@ -1424,6 +1836,7 @@ static void set_next_timeout_check(ulonglong abstime)
 TP_connection_generic::TP_connection_generic(CONNECT *c):
   TP_connection(c),
   thread_group(0),
+  worker_group(0),
   next_in_queue(0),
   prev_in_queue(0),
   abs_wait_timeout(ULONGLONG_MAX),
@@ -1448,6 +1861,7 @@ TP_connection_generic::TP_connection_generic(CONNECT *c):
     &all_groups[c->thread_id%group_count];
 
   thread_group=group;
+  worker_group=group;
 
   mysql_mutex_lock(&group->mutex);
   group->connection_count++;
@@ -1504,7 +1918,7 @@ static int change_group(TP_connection_generic *c,
   mysql_mutex_lock(&old_group->mutex);
   if (c->bound_to_poll_descriptor)
   {
-    io_poll_disassociate_fd(old_group->pollfd,c->fd);
+    io_poll_disassociate_fd(old_group,c->fd);
     c->bound_to_poll_descriptor= false;
   }
   c->thread_group->connection_count--;
@@ -1551,10 +1965,15 @@ int TP_connection_generic::start_io()
   if (!bound_to_poll_descriptor)
   {
     bound_to_poll_descriptor= true;
-    return io_poll_associate_fd(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+    return io_poll_associate_fd(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
   }
   
-  return io_poll_start_read(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+  int ret= io_poll_start_read(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+
+  /* A worker of another group only flushes its own group in get_event() */
+  if (worker_group != thread_group)
+    io_poll_flush(thread_group);
+  return ret;
 }
 
 
@@ -1589,6 +2008,7 @@ static void *worker_main(void *param)
     if (!connection)
       break;
     this_thread.event_count++;
+    connection->worker_group= thread_group;
     tp_callback(connection);
   }
 
@@ -1676,7 +2096,7 @@ int TP_pool_generic::set_pool_size(uint size)
     mysql_mutex_lock(&group->mutex);
     if (group->pollfd == INVALID_HANDLE_VALUE)
     {
-      group->pollfd= io_poll_create();
+      group->pollfd= io_poll_create(group);
       success= (group->pollfd != INVALID_HANDLE_VALUE);
       if(!success)
       {
@@ -1722,6 +2142,19 @@ int TP_pool_generic::get_idle_thread_count()
 }
 
 
+/** Copy the queue wait histogram of a group, see TP_QUEUE_WAIT_STATS */
+int TP_pool_generic::get_queue_wait_stats(uint group,
+                                          TP_QUEUE_WAIT_STATS *stats)
+{
+  if (group >= group_count)
+    return -1;
+  mysql_mutex_lock(&all_groups[group].mutex);
+  *stats= all_groups[group].queue_wait;
+  mysql_mutex_unlock(&all_groups[group].mutex);
+  return 0;
+}
+
+
 /* Report threadpool problems */
 
 /** 
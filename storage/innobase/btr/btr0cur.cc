@@ -4252,7 +4252,7 @@ btr_cur_update_in_place(
 				btr_search_update_hash_on_delete(cursor);
 			}
 
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(ahi_latch);
 		}
 
 		assert_block_ahi_valid(block);
@@ -4262,7 +4262,7 @@ btr_cur_update_in_place(
 
 #ifdef BTR_CUR_HASH_ADAPT
 		if (ahi_latch) {
-			rw_lock_x_unlock(ahi_latch);
+			btr_search_x_unlock(ahi_latch);
 		}
 	}
 #endif /* BTR_CUR_HASH_ADAPT */
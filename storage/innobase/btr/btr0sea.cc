@@ -50,6 +50,11 @@ char		btr_search_enabled;
 /** Number of adaptive hash index partition. */
 ulong		btr_ahi_parts;
 
+/** Minimum adaptive hash index hit ratio of an index, in per cent,
+below which no further page hash indexes are built for the index;
+0 disables the check */
+ulong		btr_search_min_hit_pct;
+
 #ifdef UNIV_SEARCH_PERF_STAT
 /** Number of successful adaptive hash index lookups */
 ulint		btr_search_n_succ	= 0;
@@ -209,7 +214,7 @@ btr_search_check_free_space_in_heap(const dict_index_t* index)
 		buf_block_t*	block = buf_block_alloc(NULL);
 		rw_lock_t*	ahi_latch = btr_get_search_latch(index);
 
-		rw_lock_x_lock(ahi_latch);
+		btr_search_x_lock(ahi_latch);
 
 		if (btr_search_enabled
 		    && heap->free_block == NULL) {
@@ -218,7 +223,7 @@ btr_search_check_free_space_in_heap(const dict_index_t* index)
 			buf_block_free(block);
 		}
 
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(ahi_latch);
 	}
 }
 
@@ -230,17 +235,23 @@ void btr_search_sys_create(ulint hash_size)
 	Each part controls access to distinct set of hash buckets from
 	hash table through its own latch. */
 
-	/* Step-1: Allocate latches (1 per part). */
+	/* Step-1: Allocate latches (BTR_SEARCH_N_SLOTS per part). */
 	btr_search_latches = reinterpret_cast<rw_lock_t**>(
 		ut_malloc(sizeof(rw_lock_t*) * btr_ahi_parts, mem_key_ahi));
 
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 
-		btr_search_latches[i] = reinterpret_cast<rw_lock_t*>(
-			ut_malloc(sizeof(rw_lock_t), mem_key_ahi));
+		btr_search_slot_t*	slots
+			= reinterpret_cast<btr_search_slot_t*>(
+				ut_zalloc(sizeof(btr_search_slot_t)
+					  * BTR_SEARCH_N_SLOTS, mem_key_ahi));
+
+		btr_search_latches[i] = &slots->latch;
 
-		rw_lock_create(btr_search_latch_key,
-			       btr_search_latches[i], SYNC_SEARCH_SYS);
+		for (ulint j = 0; j < BTR_SEARCH_N_SLOTS; ++j) {
+			rw_lock_create(btr_search_latch_key,
+				       &slots[j].latch, SYNC_SEARCH_SYS);
+		}
 	}
 
 	/* Step-2: Allocate hash tablees. */
@@ -325,7 +336,11 @@ void btr_search_sys_free()
 	/* Step-2: Release all allocates latches. */
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 
-		rw_lock_free(btr_search_latches[i]);
+		for (ulint j = 0; j < BTR_SEARCH_N_SLOTS; ++j) {
+			rw_lock_free(&btr_search_slot(
+					     btr_search_latches[i], j)->latch);
+		}
+
 		ut_free(btr_search_latches[i]);
 	}
 
@@ -437,8 +452,7 @@ btr_search_info_get_ref_count(
 
 	ut_ad(info);
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	rw_lock_s_lock(ahi_latch);
+	rw_lock_t* ahi_latch = btr_search_s_lock(btr_get_search_latch(index));
 	ret = info->ref_count;
 	rw_lock_s_unlock(ahi_latch);
 
@@ -895,7 +909,8 @@ btr_search_guess_on_hash(
 
 	ut_ad(index && info && tuple && cursor && mtr);
 	ut_ad(!dict_index_is_ibuf(index));
-	ut_ad(!ahi_latch || ahi_latch == btr_get_search_latch(index));
+	ut_ad(!ahi_latch
+	      || btr_search_is_slot(ahi_latch, btr_get_search_latch(index)));
 	ut_ad((latch_mode == BTR_SEARCH_LEAF)
 	      || (latch_mode == BTR_MODIFY_LEAF));
 
@@ -928,11 +943,13 @@ btr_search_guess_on_hash(
 	cursor->fold = fold;
 	cursor->flag = BTR_CUR_HASH;
 
-	rw_lock_t* use_latch = ahi_latch ? NULL : btr_get_search_latch(index);
+	rw_lock_t* use_latch = ahi_latch
+		? NULL : btr_search_s_lock(btr_get_search_latch(index));
+	/* The slot for the partition statistics */
+	btr_search_slot_t* slot = btr_search_slot(
+		ahi_latch ? ahi_latch : use_latch, 0);
 
 	if (use_latch) {
-		rw_lock_s_lock(use_latch);
-
 		if (!btr_search_enabled) {
 			goto fail;
 		}
@@ -950,6 +967,7 @@ btr_search_guess_on_hash(
 			rw_lock_s_unlock(use_latch);
 		}
 
+		slot->n_misses++;
 		btr_search_failure(info, cursor);
 
 		return(FALSE);
@@ -979,6 +997,7 @@ btr_search_guess_on_hash(
 			btr_leaf_page_release(block, latch_mode, mtr);
 		}
 
+		slot->n_misses++;
 		btr_search_failure(info, cursor);
 
 		return(FALSE);
@@ -1002,6 +1021,7 @@ btr_search_guess_on_hash(
 			btr_leaf_page_release(block, latch_mode, mtr);
 		}
 
+		slot->n_misses++;
 		btr_search_failure(info, cursor);
 
 		return(FALSE);
@@ -1048,6 +1068,8 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	info->n_hits++;
+	slot->n_hits++;
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1124,11 +1146,11 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 		% btr_ahi_parts;
 	latch = btr_search_latches[ahi_slot];
 
-	rw_lock_s_lock(latch);
+	rw_lock_t*	s_latch = btr_search_s_lock(latch);
 	assert_block_ahi_valid(block);
 
 	if (block->index == NULL) {
-		rw_lock_s_unlock(latch);
+		rw_lock_s_unlock(s_latch);
 		return;
 	}
 
@@ -1174,7 +1196,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 	/* NOTE: The AHI fields of block must not be accessed after
 	releasing search latch, as the index page might only be s-latched! */
 
-	rw_lock_s_unlock(latch);
+	rw_lock_s_unlock(s_latch);
 
 	ut_a(n_fields > 0 || n_bytes > 0);
 
@@ -1225,7 +1247,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(latch);
+	btr_search_x_lock(latch);
 
 	if (UNIV_UNLIKELY(!block->index)) {
 		/* Someone else has meanwhile dropped the hash index */
@@ -1241,7 +1263,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 		/* Someone else has meanwhile built a new hash index on the
 		page, with different parameters */
 
-		rw_lock_x_unlock(latch);
+		btr_search_x_unlock(latch);
 
 		ut_free(folds);
 		goto retry;
@@ -1265,7 +1287,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 
 cleanup:
 	assert_block_ahi_valid(block);
-	rw_lock_x_unlock(latch);
+	btr_search_x_unlock(latch);
 
 	ut_free(folds);
 }
@@ -1363,14 +1385,14 @@ btr_search_build_page_hash_index(
 	ut_ad(rw_lock_own_flagged(&block->lock,
 				  RW_LOCK_FLAG_X | RW_LOCK_FLAG_S));
 
-	rw_lock_s_lock(ahi_latch);
+	rw_lock_t*	s_latch = btr_search_s_lock(ahi_latch);
 
 	const bool rebuild = block->index
 		&& (block->curr_n_fields != n_fields
 		    || block->curr_n_bytes != n_bytes
 		    || block->curr_left_side != left_side);
 
-	rw_lock_s_unlock(ahi_latch);
+	rw_lock_s_unlock(s_latch);
 
 	if (rebuild) {
 		btr_search_drop_page_hash_index(block);
@@ -1473,7 +1495,7 @@ btr_search_build_page_hash_index(
 	btr_search_check_free_space_in_heap(index);
 
 	hash_table_t*	table	= btr_get_search_table(index);
-	rw_lock_x_lock(ahi_latch);
+	btr_search_x_lock(ahi_latch);
 
 	if (!btr_search_enabled) {
 		goto exit_func;
@@ -1511,7 +1533,7 @@ btr_search_build_page_hash_index(
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
 	assert_block_ahi_valid(block);
-	rw_lock_x_unlock(ahi_latch);
+	btr_search_x_unlock(ahi_latch);
 
 	ut_free(folds);
 	ut_free(recs);
@@ -1520,6 +1542,48 @@ btr_search_build_page_hash_index(
 	}
 }
 
+/** Determine if building page hash indexes for an index should be
+suspended because the hit ratio of the adaptive hash index is low.
+Whenever the ratio of the last BTR_SEARCH_HIT_WINDOW searches is below
+btr_search_min_hit_pct, building will be suspended for an exponentially
+growing number of windows.
+NOTE that info is NOT protected by any semaphore!
+@param[in,out]	info	search info
+@return whether no page hash indexes should be built */
+static bool btr_search_info_low_hit_ratio(btr_search_t* info)
+{
+	const ulint	min_pct = btr_search_min_hit_pct;
+
+	if (!min_pct) {
+		info->n_skip = 0;
+		return(false);
+	}
+
+	const ulint	n_hits = info->n_hits;
+	const ulint	n_searches = n_hits + info->n_misses;
+
+	if (n_searches < BTR_SEARCH_HIT_WINDOW) {
+		return(info->n_skip != 0);
+	}
+
+	info->n_hits = 0;
+	info->n_misses = 0;
+
+	if (info->n_skip) {
+		info->n_skip--;
+	} else if (n_hits * 100 < n_searches * min_pct) {
+		info->n_skip_next = info->n_skip_next
+			? std::min<ulint>(info->n_skip_next * 2,
+					  BTR_SEARCH_MAX_SKIP)
+			: 1;
+		info->n_skip = info->n_skip_next;
+	} else {
+		info->n_skip_next = 0;
+	}
+
+	return(info->n_skip != 0);
+}
+
 /** Updates the search info.
 @param[in,out]	info	search info
 @param[in,out]	cursor	cursor which was just positioned */
@@ -1542,6 +1606,11 @@ btr_search_info_update_slow(btr_search_t* info, btr_cur_t* cursor)
 
 	bool build_index = btr_search_update_block_hash_info(info, block);
 
+	if (build_index && btr_search_info_low_hit_ratio(info)) {
+		MONITOR_INC(MONITOR_ADAPTIVE_HASH_BUILD_SKIPPED);
+		build_index = false;
+	}
+
 	if (build_index || (cursor->flag == BTR_CUR_HASH_FAIL)) {
 
 		btr_search_check_free_space_in_heap(cursor->index);
@@ -1554,11 +1623,11 @@ btr_search_info_update_slow(btr_search_t* info, btr_cur_t* cursor)
 		btr_search_n_hash_fail++;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-		rw_lock_x_lock(ahi_latch);
+		btr_search_x_lock(ahi_latch);
 
 		btr_search_update_hash_ref(info, block, cursor);
 
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(ahi_latch);
 	}
 
 	if (build_index) {
@@ -1611,7 +1680,7 @@ btr_search_move_or_delete_hash_entries(
 		return;
 	}
 
-	rw_lock_s_lock(ahi_latch);
+	rw_lock_t*	s_latch = btr_search_s_lock(ahi_latch);
 
 	if (block->index) {
 		ulint	n_fields = block->curr_n_fields;
@@ -1622,7 +1691,7 @@ btr_search_move_or_delete_hash_entries(
 		new_block->n_bytes = block->curr_n_bytes;
 		new_block->left_side = left_side;
 
-		rw_lock_s_unlock(ahi_latch);
+		rw_lock_s_unlock(s_latch);
 
 		ut_a(n_fields > 0 || n_bytes > 0);
 
@@ -1635,7 +1704,7 @@ btr_search_move_or_delete_hash_entries(
 		return;
 	}
 
-	rw_lock_s_unlock(ahi_latch);
+	rw_lock_s_unlock(s_latch);
 }
 
 /** Updates the page hash index when a single record is deleted from a page.
@@ -1691,7 +1760,7 @@ void btr_search_update_hash_on_delete(btr_cur_t* cursor)
 
 	rw_lock_t*	ahi_latch = btr_get_search_latch(index);
 
-	rw_lock_x_lock(ahi_latch);
+	btr_search_x_lock(ahi_latch);
 	assert_block_ahi_valid(block);
 
 	if (block->index) {
@@ -1707,7 +1776,7 @@ void btr_search_update_hash_on_delete(btr_cur_t* cursor)
 		assert_block_ahi_valid(block);
 	}
 
-	rw_lock_x_unlock(ahi_latch);
+	btr_search_x_unlock(ahi_latch);
 }
 
 /** Updates the page hash index when a single record is inserted on a page.
@@ -1748,7 +1817,7 @@ btr_search_update_hash_node_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 	ut_a(cursor->index == index);
 	ut_a(!dict_index_is_ibuf(index));
-	rw_lock_x_lock(ahi_latch);
+	btr_search_x_lock(ahi_latch);
 
 	if (!block->index) {
 
@@ -1772,9 +1841,9 @@ btr_search_update_hash_node_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 func_exit:
 		assert_block_ahi_valid(block);
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(ahi_latch);
 	} else {
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(ahi_latch);
 
 		btr_search_update_hash_on_insert(cursor, ahi_latch);
 	}
@@ -1870,7 +1939,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 	} else {
 		if (left_side) {
 			locked = true;
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(ahi_latch);
 
 			if (!btr_search_enabled) {
 				goto function_exit;
@@ -1886,7 +1955,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 		if (!locked) {
 			locked = true;
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(ahi_latch);
 
 			if (!btr_search_enabled) {
 				goto function_exit;
@@ -1906,7 +1975,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 		if (!left_side) {
 			if (!locked) {
 				locked = true;
-				rw_lock_x_lock(ahi_latch);
+				btr_search_x_lock(ahi_latch);
 
 				if (!btr_search_enabled) {
 					goto function_exit;
@@ -1923,7 +1992,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 		if (!locked) {
 			locked = true;
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(ahi_latch);
 
 			if (!btr_search_enabled) {
 				goto function_exit;
@@ -1942,7 +2011,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 		mem_heap_free(heap);
 	}
 	if (locked) {
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(ahi_latch);
 	}
 	ut_ad(!rw_lock_own(ahi_latch, RW_LOCK_X));
 }
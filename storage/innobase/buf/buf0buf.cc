@@ -701,6 +701,9 @@ buf_get_total_stat(
 		tot_stat->n_page_gets += buf_stat->n_page_gets;
 		tot_stat->n_pages_read += buf_stat->n_pages_read;
 		tot_stat->n_pages_written += buf_stat->n_pages_written;
+		tot_stat->n_pages_flushed_LRU += buf_stat->n_pages_flushed_LRU;
+		tot_stat->n_pages_flushed_list
+			+= buf_stat->n_pages_flushed_list;
 		tot_stat->n_pages_created += buf_stat->n_pages_created;
 		tot_stat->n_ra_pages_read_rnd += buf_stat->n_ra_pages_read_rnd;
 		tot_stat->n_ra_pages_read += buf_stat->n_ra_pages_read;
@@ -1968,6 +1971,9 @@ buf_pool_init_instance(
 	/* Initialize the iterator for single page scan search */
 	new(&buf_pool->single_scan_itr) LRUItr(buf_pool, &buf_pool->mutex);
 
+	/* Initialize the hazard pointer for buffer pool dumps */
+	new(&buf_pool->dump_hp) LRUHp(buf_pool, &buf_pool->mutex);
+
 	/* Initialize the temporal memory array and slots */
 	new(&buf_pool->io_buf) buf_pool_t::io_buf_t(
 		(srv_n_read_io_threads + srv_n_write_io_threads)
@@ -2119,6 +2125,8 @@ buf_pool_free(
 
 	ut_free(buf_pool_ptr);
 	buf_pool_ptr = NULL;
+
+	fil_comp_ctx_pool_free();
 }
 
 /** Reallocate a control block.
@@ -6915,6 +6923,8 @@ buf_stats_aggregate_pool_info(
 	total_info->n_pages_read += pool_info->n_pages_read;
 	total_info->n_pages_created += pool_info->n_pages_created;
 	total_info->n_pages_written += pool_info->n_pages_written;
+	total_info->n_pages_flushed_LRU += pool_info->n_pages_flushed_LRU;
+	total_info->n_pages_flushed_list += pool_info->n_pages_flushed_list;
 	total_info->n_page_gets += pool_info->n_page_gets;
 	total_info->n_ra_pages_read_rnd += pool_info->n_ra_pages_read_rnd;
 	total_info->n_ra_pages_read += pool_info->n_ra_pages_read;
@@ -6925,6 +6935,9 @@ buf_stats_aggregate_pool_info(
 	total_info->pages_read_rate += pool_info->pages_read_rate;
 	total_info->pages_created_rate += pool_info->pages_created_rate;
 	total_info->pages_written_rate += pool_info->pages_written_rate;
+	total_info->pages_flushed_LRU_rate += pool_info->pages_flushed_LRU_rate;
+	total_info->pages_flushed_list_rate
+		+= pool_info->pages_flushed_list_rate;
 	total_info->n_page_get_delta += pool_info->n_page_get_delta;
 	total_info->page_read_delta += pool_info->page_read_delta;
 	total_info->young_making_delta += pool_info->young_making_delta;
@@ -7005,6 +7018,10 @@ buf_stats_get_pool_info(
 
 	pool_info->n_pages_written = buf_pool->stat.n_pages_written;
 
+	pool_info->n_pages_flushed_LRU = buf_pool->stat.n_pages_flushed_LRU;
+
+	pool_info->n_pages_flushed_list = buf_pool->stat.n_pages_flushed_list;
+
 	pool_info->n_page_gets = buf_pool->stat.n_page_gets;
 
 	pool_info->n_ra_pages_read_rnd = buf_pool->stat.n_ra_pages_read_rnd;
@@ -7032,6 +7049,14 @@ buf_stats_get_pool_info(
 		(buf_pool->stat.n_pages_written
 		 - buf_pool->old_stat.n_pages_written) / time_elapsed;
 
+	pool_info->pages_flushed_LRU_rate =
+		(buf_pool->stat.n_pages_flushed_LRU
+		 - buf_pool->old_stat.n_pages_flushed_LRU) / time_elapsed;
+
+	pool_info->pages_flushed_list_rate =
+		(buf_pool->stat.n_pages_flushed_list
+		 - buf_pool->old_stat.n_pages_flushed_list) / time_elapsed;
+
 	pool_info->n_page_get_delta = buf_pool->stat.n_page_gets
 				      - buf_pool->old_stat.n_page_gets;
 
@@ -7126,6 +7151,14 @@ buf_print_io_instance(
 		pool_info->pages_created_rate,
 		pool_info->pages_written_rate);
 
+	fprintf(file,
+		"Pages flushed by LRU " ULINTPF ", flush list " ULINTPF "\n"
+		"%.2f LRU flushes/s, %.2f flush list flushes/s\n",
+		pool_info->n_pages_flushed_LRU,
+		pool_info->n_pages_flushed_list,
+		pool_info->pages_flushed_LRU_rate,
+		pool_info->pages_flushed_list_rate);
+
 	if (pool_info->n_page_get_delta) {
 		double hit_rate = double(pool_info->page_read_delta)
 			/ pool_info->n_page_get_delta;
@@ -33,6 +33,7 @@ Created 2011/12/19
 #include "trx0sys.h"
 #include "fil0crypt.h"
 #include "fil0pagecompress.h"
+#include "buf0flu.h"
 
 /** The doublewrite buffer */
 buf_dblwr_t*	buf_dblwr = NULL;
@@ -108,6 +109,358 @@ buf_dblwr_sync_datafiles()
 	os_aio_wait_until_no_pending_writes();
 }
 
+/** Build the path name of a parallel doublewrite file.
+@param[in]	i	buffer pool instance number
+@return path name, to be freed with ut_free() */
+static
+char*
+buf_dblwr_file_path(ulint i)
+{
+	char	name[sizeof "ib_dblwr" + 20];
+
+	snprintf(name, sizeof name, "ib_dblwr" ULINTPF, i);
+
+	return(fil_make_filepath(NULL, name, NO_EXT, false));
+}
+
+/** Get the batch area of the parallel doublewrite files for a batch.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	flush_type	BUF_FLUSH_LRU or BUF_FLUSH_LIST
+@return batch area */
+static inline
+buf_dblwr_shard_t*
+buf_dblwr_get_shard(const buf_pool_t* buf_pool, buf_flush_t flush_type)
+{
+	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
+
+	return(&buf_dblwr->shards[buf_pool->instance_no * 2
+				  + (flush_type == BUF_FLUSH_LRU)]);
+}
+
+/** Free the batch areas of the parallel doublewrite files.
+@param[in]	n	number of initialized batch areas */
+static
+void
+buf_dblwr_shards_free(ulint n)
+{
+	for (ulint i = 0; i < n; i++) {
+		buf_dblwr_shard_t*	shard = &buf_dblwr->shards[i];
+
+		ut_ad(shard->b_reserved == 0);
+
+		if (!(i & 1)) {
+			/* The two areas share the file. */
+			os_file_close(shard->file);
+			ut_free(const_cast<char*>(shard->path));
+		}
+
+		os_event_destroy(shard->b_event);
+		ut_free(shard->write_buf_unaligned);
+		ut_free(shard->buf_block_arr);
+		mutex_free(&shard->mutex);
+	}
+
+	ut_free(buf_dblwr->shards);
+	buf_dblwr->shards = NULL;
+}
+
+/** Open or create the parallel doublewrite files, one per buffer pool
+instance, and initialize their batch areas.
+@return whether the files were opened */
+static
+bool
+buf_dblwr_shards_init()
+{
+	const ulint	n = srv_buf_pool_instances * 2;
+	const ulint	size = srv_parallel_doublewrite_batch_size;
+
+	buf_dblwr->shards = static_cast<buf_dblwr_shard_t*>(
+		ut_zalloc_nokey(n * sizeof *buf_dblwr->shards));
+
+	for (ulint i = 0; i < n; i++) {
+		buf_dblwr_shard_t*	shard = &buf_dblwr->shards[i];
+
+		if (i & 1) {
+			shard->file = shard[-1].file;
+			shard->path = shard[-1].path;
+		} else {
+			char*	path = buf_dblwr_file_path(i / 2);
+			bool	success;
+
+			/* Keep any existing contents for
+			buf_dblwr_load_files() and buf_dblwr_process(). */
+			shard->file = os_file_create(
+				innodb_data_file_key, path,
+				OS_FILE_OPEN | OS_FILE_ON_ERROR_NO_EXIT
+				| OS_FILE_ON_ERROR_SILENT,
+				OS_FILE_NORMAL, OS_DATA_FILE, false,
+				&success);
+
+			if (!success) {
+				shard->file = os_file_create(
+					innodb_data_file_key, path,
+					OS_FILE_CREATE
+					| OS_FILE_ON_ERROR_NO_EXIT,
+					OS_FILE_NORMAL, OS_DATA_FILE, false,
+					&success);
+			}
+
+			if (!success) {
+				ib::warn() << "Cannot open " << path
+					<< "; writing the doublewrite copies"
+					" of batches to the system tablespace";
+				ut_free(path);
+				buf_dblwr_shards_free(i);
+				return(false);
+			}
+
+			shard->path = path;
+		}
+
+		mutex_create(LATCH_ID_BUF_DBLWR, &shard->mutex);
+		shard->b_event = os_event_create("dblwr_shard_event");
+		shard->offset = os_offset_t(i & 1) * size
+			<< srv_page_size_shift;
+		shard->write_buf_unaligned = static_cast<byte*>(
+			ut_malloc_nokey((1 + size) << srv_page_size_shift));
+		shard->write_buf = static_cast<byte*>(
+			ut_align(shard->write_buf_unaligned, srv_page_size));
+		shard->buf_block_arr = static_cast<buf_page_t**>(
+			ut_zalloc_nokey(size * sizeof(void*)));
+	}
+
+	return(true);
+}
+
+/** Check if a parallel doublewrite file exists. os_file_get_size()
+reports a missing file as ~0U on POSIX but as ~0 on Windows.
+@param[in]	path	file name
+@return whether the file exists */
+static
+bool
+buf_dblwr_file_exists(const char* path)
+{
+	bool		exists;
+	os_file_type_t	type;
+
+	return(os_file_status(path, &exists, &type) && exists);
+}
+
+/** Read the parallel doublewrite files one batch area at a time, and
+invoke a callback on each page that carries a nonzero FIL_PAGE_LSN.
+@param[in,out]	read_buf	buffer for srv_parallel_doublewrite_batch_size
+				pages
+@param[in]	f		callback
+@return DB_SUCCESS or error code */
+template<typename F>
+static
+dberr_t
+buf_dblwr_scan_files(byte* read_buf, F& f)
+{
+	const ulint	area = srv_parallel_doublewrite_batch_size
+		<< srv_page_size_shift;
+	IORequest	read_request(IORequest::READ);
+
+	for (ulint i = 0;; i++) {
+		char*		path = buf_dblwr_file_path(i);
+
+		if (!buf_dblwr_file_exists(path)) {
+			ut_free(path);
+			return(DB_SUCCESS);
+		}
+
+		os_file_size_t	size = os_file_get_size(path);
+
+		/* Ignore any incomplete page at the end. */
+		size.m_total_size &= ~os_offset_t(srv_page_size - 1);
+
+		if (!size.m_total_size) {
+			ut_free(path);
+			continue;
+		}
+
+		bool		success;
+		pfs_os_file_t	file = os_file_create(
+			innodb_data_file_key, path,
+			OS_FILE_OPEN | OS_FILE_ON_ERROR_NO_EXIT,
+			OS_FILE_NORMAL, OS_DATA_FILE, true, &success);
+
+		if (!success) {
+			ib::error() << "Cannot open " << path;
+			ut_free(path);
+			return(DB_ERROR);
+		}
+
+		for (os_offset_t offset = 0; offset < size.m_total_size;
+		     offset += area) {
+			const ulint	len = ulint(std::min<os_offset_t>(
+				area, size.m_total_size - offset));
+			dberr_t		err = os_file_read(
+				read_request, file, read_buf, offset, len);
+
+			if (err != DB_SUCCESS) {
+				ib::error() << "Failed to read " << path;
+				os_file_close(file);
+				ut_free(path);
+				return(err);
+			}
+
+			for (const byte* page = read_buf;
+			     page < read_buf + len; page += srv_page_size) {
+				/* Each valid page header must contain
+				a nonzero FIL_PAGE_LSN field. */
+				if (memcmp(field_ref_zero,
+					   page + FIL_PAGE_LSN, 8)) {
+					f(page);
+				}
+			}
+		}
+
+		os_file_close(file);
+		ut_free(path);
+	}
+}
+
+/** Count the valid pages of the parallel doublewrite files. */
+struct buf_dblwr_count_t
+{
+	ulint	n;
+
+	buf_dblwr_count_t() : n(0) {}
+
+	void operator()(const byte*) { n++; }
+};
+
+/** Copy the valid pages of the parallel doublewrite files to
+buf_dblwr->recv_buf, and register them for recovery. */
+struct buf_dblwr_copy_t
+{
+	byte*	buf;
+	byte*	end;
+
+	buf_dblwr_copy_t(byte* buf, ulint n)
+		: buf(buf), end(buf + (n << srv_page_size_shift)) {}
+
+	void operator()(const byte* page)
+	{
+		/* The files must not change between the two scans. */
+		ut_a(buf < end);
+		memcpy(buf, page, srv_page_size);
+		recv_sys.dblwr.add(buf);
+		buf += srv_page_size;
+	}
+};
+
+/** Read the pages of the parallel doublewrite files that may have been
+left behind by a previous run into buf_dblwr->recv_buf, and register them
+for recovery. All the files that exist are read, even if
+innodb_buffer_pool_instances or innodb_parallel_doublewrite_batch_size
+was changed in the meantime. The files are read one batch area at a time,
+and only the pages that carry a nonzero FIL_PAGE_LSN are kept. The files
+are not read when innodb_parallel_doublewrite=OFF.
+@return DB_SUCCESS or error code */
+static
+dberr_t
+buf_dblwr_load_files()
+{
+	if (!srv_parallel_doublewrite) {
+		for (ulint i = 0;; i++) {
+			char*		path = buf_dblwr_file_path(i);
+
+			if (!buf_dblwr_file_exists(path)) {
+				ut_free(path);
+				break;
+			}
+
+			os_file_size_t	size = os_file_get_size(path);
+
+			if (size.m_total_size) {
+				ib::warn() << "Ignoring " << path
+					<< " because innodb_parallel_doublewrite"
+					"=OFF. If the server was killed while"
+					" innodb_parallel_doublewrite=ON,"
+					" restart with it ON to recover"
+					" any torn pages.";
+			}
+
+			ut_free(path);
+		}
+
+		return(DB_SUCCESS);
+	}
+
+	byte*	unaligned_read_buf = static_cast<byte*>(
+		ut_malloc_nokey((1 + srv_parallel_doublewrite_batch_size)
+				<< srv_page_size_shift));
+	byte*	read_buf = static_cast<byte*>(
+		ut_align(unaligned_read_buf, srv_page_size));
+
+	buf_dblwr_count_t	count;
+	dberr_t			err = buf_dblwr_scan_files(read_buf, count);
+
+	if (err == DB_SUCCESS && count.n) {
+		buf_dblwr->recv_buf = static_cast<byte*>(
+			ut_malloc_nokey((1 + count.n) << srv_page_size_shift));
+
+		buf_dblwr_copy_t	copy(static_cast<byte*>(
+			ut_align(buf_dblwr->recv_buf, srv_page_size)),
+					     count.n);
+
+		err = buf_dblwr_scan_files(read_buf, copy);
+	}
+
+	ut_free(unaligned_read_buf);
+	return(err);
+}
+
+/** Discard the contents of the parallel doublewrite files after
+buf_dblwr_process() has restored any torn pages from them. The files of
+the current buffer pool instances are truncated; any files left behind
+by a larger innodb_buffer_pool_instances are deleted. */
+static
+void
+buf_dblwr_reset_files()
+{
+	if (!srv_parallel_doublewrite || srv_read_only_mode) {
+		return;
+	}
+
+	for (ulint i = 0;; i++) {
+		char*	path = buf_dblwr_file_path(i);
+
+		if (i >= srv_buf_pool_instances) {
+			bool	exist;
+
+			os_file_delete_if_exists(
+				innodb_data_file_key, path, &exist);
+			ut_free(path);
+
+			if (!exist) {
+				return;
+			}
+
+			continue;
+		}
+
+		bool		success;
+		pfs_os_file_t	file = os_file_create(
+			innodb_data_file_key, path,
+			OS_FILE_OPEN | OS_FILE_ON_ERROR_NO_EXIT
+			| OS_FILE_ON_ERROR_SILENT,
+			OS_FILE_NORMAL, OS_DATA_FILE, false, &success);
+
+		if (success) {
+			if (!os_file_truncate(path, file, 0, true)) {
+				ib::warn() << "Cannot truncate " << path;
+			}
+
+			os_file_close(file);
+		}
+
+		ut_free(path);
+	}
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -156,6 +509,14 @@ buf_dblwr_init(
 
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		ut_zalloc_nokey(buf_size * sizeof(void*)));
+
+	if (srv_parallel_doublewrite && srv_use_doublewrite_buf
+	    && !srv_read_only_mode && buf_dblwr_shards_init()) {
+		ib::info() << "Using " << srv_buf_pool_instances
+			<< " parallel doublewrite files of "
+			<< (2 * srv_parallel_doublewrite_batch_size)
+			<< " pages";
+	}
 }
 
 /** Create the doublewrite buffer if the doublewrite buffer header
@@ -513,7 +874,17 @@ buf_dblwr_init_or_load_pages(
 
 	ut_free(unaligned_read_buf);
 
-	return(DB_SUCCESS);
+	return(buf_dblwr_load_files());
+}
+
+/** Compare the FIL_PAGE_LSN of two doublewrite copies.
+@return whether the first copy is newer than the second */
+static
+bool
+buf_dblwr_newer(const byte* a, const byte* b)
+{
+	return(mach_read_from_8(a + FIL_PAGE_LSN)
+	       > mach_read_from_8(b + FIL_PAGE_LSN));
 }
 
 /** Process and remove the double write buffer pages for all tablespaces. */
@@ -536,6 +907,10 @@ buf_dblwr_process()
 		ut_align(unaligned_read_buf, srv_page_size));
 	byte* const buf = read_buf + srv_page_size;
 
+	/* There may be several copies of a page, in the system tablespace
+	and in the parallel doublewrite files. Try the newest one first. */
+	recv_dblwr.pages.sort(buf_dblwr_newer);
+
 	for (recv_dblwr_t::list::iterator i = recv_dblwr.pages.begin();
 	     i != recv_dblwr.pages.end();
 	     ++i, ++page_no_dblwr) {
@@ -690,6 +1065,12 @@ buf_dblwr_process()
 
 	fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
 	ut_free(unaligned_read_buf);
+	ut_free(buf_dblwr->recv_buf);
+	buf_dblwr->recv_buf = NULL;
+
+	/* The recovered pages are durable. Do not let a later
+	recovery restore these copies again. */
+	buf_dblwr_reset_files();
 }
 
 /****************************************************************//**
@@ -702,6 +1083,20 @@ buf_dblwr_free()
 	ut_ad(buf_dblwr->s_reserved == 0);
 	ut_ad(buf_dblwr->b_reserved == 0);
 
+	if (buf_dblwr->shards) {
+		buf_dblwr_shards_free(srv_buf_pool_instances * 2);
+
+		if (srv_was_started) {
+			/* Every batch is durable in the data files.
+			Leave empty files, so that a restart with
+			innodb_parallel_doublewrite=OFF has nothing
+			to warn about. */
+			buf_dblwr_reset_files();
+		}
+	}
+
+	ut_free(buf_dblwr->recv_buf);
+
 	os_event_destroy(buf_dblwr->b_event);
 	os_event_destroy(buf_dblwr->s_event);
 	ut_free(buf_dblwr->write_buf_unaligned);
@@ -718,6 +1113,40 @@ buf_dblwr_free()
 	buf_dblwr = NULL;
 }
 
+/** Update a batch area of the parallel doublewrite files when a page
+write of the batch has been completed.
+@param[in,out]	shard	batch area */
+static
+void
+buf_dblwr_shard_update(buf_dblwr_shard_t* shard)
+{
+	mutex_enter(&shard->mutex);
+
+	ut_ad(shard->batch_running);
+	ut_ad(shard->b_reserved > 0);
+	ut_ad(shard->b_reserved <= shard->first_free);
+
+	if (!--shard->b_reserved) {
+		mutex_exit(&shard->mutex);
+		/* This will finish the batch. Sync data files
+		to the disk. */
+		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+
+		/* The copies of the batch are left in the file.
+		buf_dblwr_process() only restores a page that is
+		corrupted in the data file, from the copy with the
+		newest FIL_PAGE_LSN. */
+		mutex_enter(&shard->mutex);
+
+		/* We can now reuse the doublewrite memory buffer: */
+		shard->first_free = 0;
+		shard->batch_running = false;
+		os_event_set(shard->b_event);
+	}
+
+	mutex_exit(&shard->mutex);
+}
+
 /********************************************************************//**
 Updates the doublewrite buffer when an IO request is completed. */
 void
@@ -734,6 +1163,12 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
+		if (buf_dblwr->shards) {
+			buf_dblwr_shard_update(buf_dblwr_get_shard(
+				buf_pool_from_bpage(bpage), flush_type));
+			break;
+		}
+
 		mutex_enter(&buf_dblwr->mutex);
 
 		ut_ad(buf_dblwr->batch_running);
@@ -941,14 +1376,97 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+/** Write the buffered batch of a parallel doublewrite file area to the
+file with one sequential write, sync the file, and then post the writes
+of the pages to the data files.
+@param[in,out]	shard	batch area */
+static
 void
-buf_dblwr_flush_buffered_writes()
+buf_dblwr_shard_flush(buf_dblwr_shard_t* shard)
+{
+	ulint	first_free;
+
+try_again:
+	mutex_enter(&shard->mutex);
+
+	if (shard->first_free == 0) {
+		mutex_exit(&shard->mutex);
+		os_aio_simulated_wake_handler_threads();
+		return;
+	}
+
+	if (shard->batch_running) {
+		/* Another thread is running the batch right now. Wait
+		for it to finish. */
+		int64_t	sig_count = os_event_reset(shard->b_event);
+		mutex_exit(&shard->mutex);
+
+		os_event_wait_low(shard->b_event, sig_count);
+		goto try_again;
+	}
+
+	ut_ad(shard->first_free == shard->b_reserved);
+
+	shard->batch_running = true;
+	first_free = shard->first_free;
+
+	mutex_exit(&shard->mutex);
+
+	for (ulint i = 0; i < first_free; i++) {
+		const buf_block_t*	block
+			= (buf_block_t*) shard->buf_block_arr[i];
+
+		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+		    || block->page.zip.data) {
+			/* No simple validate for compressed
+			pages exists. */
+			continue;
+		}
+
+		/* Check that the actual page in the buffer pool is
+		not corrupt and the LSN values are sane. */
+		buf_dblwr_check_block(block);
+		ut_d(buf_dblwr_check_page_lsn(
+			     block->page,
+			     shard->write_buf + (i << srv_page_size_shift)));
+	}
+
+	IORequest	request(IORequest::WRITE);
+	dberr_t		err = os_file_write(
+		request, shard->path, shard->file, shard->write_buf,
+		shard->offset, first_free << srv_page_size_shift);
+
+	if (err != DB_SUCCESS || !os_file_flush(shard->file)) {
+		ib::fatal() << "Cannot write the doublewrite batch to "
+			<< shard->path;
+	}
+
+	srv_stats.dblwr_pages_written.add(first_free);
+	srv_stats.dblwr_writes.inc();
+
+	DBUG_EXECUTE_IF("ib_dblwr_shard_crash", DBUG_SUICIDE(););
+
+	/* The batch is durable in the doublewrite file. Next do the
+	writes to the intended positions. */
+	for (ulint i = 0; i < first_free; i++) {
+		buf_dblwr_write_block_to_datafile(
+			shard->buf_block_arr[i], false);
+	}
+
+	os_aio_simulated_wake_handler_threads();
+}
+
+/** Flush possible buffered writes of a batch from the doublewrite memory
+buffer to disk, and also wake up the aio thread if simulated aio is used.
+It is very important to call this function after a batch of writes has
+been posted, and also when we may have to wait for a page latch!
+Otherwise a deadlock of threads can occur.
+@param[in]	buf_pool	buffer pool instance of the batch
+@param[in]	flush_type	BUF_FLUSH_LRU or BUF_FLUSH_LIST */
+void
+buf_dblwr_flush_buffered_writes(
+	const buf_pool_t*	buf_pool,
+	buf_flush_t		flush_type)
 {
 	byte*		write_buf;
 	ulint		first_free;
@@ -964,6 +1482,12 @@ buf_dblwr_flush_buffered_writes()
 
 	ut_ad(!srv_read_only_mode);
 
+	if (buf_dblwr->shards) {
+		buf_dblwr_shard_flush(
+			buf_dblwr_get_shard(buf_pool, flush_type));
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1090,6 +1614,67 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/** Copy a page to the batch area of a parallel doublewrite file. If the
+area is full, write it out first.
+@param[in,out]	shard	batch area
+@param[in]	bpage	buffer block to write */
+static
+void
+buf_dblwr_shard_add(buf_dblwr_shard_t* shard, buf_page_t* bpage)
+{
+try_again:
+	mutex_enter(&shard->mutex);
+
+	ut_a(shard->first_free <= srv_parallel_doublewrite_batch_size);
+
+	if (shard->batch_running) {
+		int64_t	sig_count = os_event_reset(shard->b_event);
+		mutex_exit(&shard->mutex);
+
+		os_event_wait_low(shard->b_event, sig_count);
+		goto try_again;
+	}
+
+	if (shard->first_free == srv_parallel_doublewrite_batch_size) {
+		mutex_exit(&shard->mutex);
+		buf_dblwr_shard_flush(shard);
+		goto try_again;
+	}
+
+	byte*	p = shard->write_buf
+		+ (shard->first_free << srv_page_size_shift);
+
+	/* We request frame here to get correct buffer in case of
+	encryption and/or page compression */
+	void * frame = buf_page_get_frame(bpage);
+
+	if (auto zip_size = bpage->zip_size()) {
+		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
+		/* Copy the compressed page and clear the rest. */
+		memcpy(p, frame, zip_size);
+		memset(p + zip_size, 0x0, srv_page_size - zip_size);
+	} else {
+		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
+
+		UNIV_MEM_ASSERT_RW(frame, srv_page_size);
+		memcpy(p, frame, srv_page_size);
+	}
+
+	shard->buf_block_arr[shard->first_free++] = bpage;
+	shard->b_reserved++;
+
+	ut_ad(shard->first_free == shard->b_reserved);
+
+	const bool	full = shard->first_free
+		== srv_parallel_doublewrite_batch_size;
+
+	mutex_exit(&shard->mutex);
+
+	if (full) {
+		buf_dblwr_shard_flush(shard);
+	}
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1101,6 +1686,15 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+	buf_flush_t	flush_type = buf_page_get_flush_type(bpage);
+
+	if (buf_dblwr->shards) {
+		buf_dblwr_shard_add(buf_dblwr_get_shard(buf_pool, flush_type),
+				    bpage);
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1124,7 +1718,7 @@ buf_dblwr_add_to_batch(
 	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
 		mutex_exit(&(buf_dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 
 		goto try_again;
 	}
@@ -1160,7 +1754,7 @@ buf_dblwr_add_to_batch(
 	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
 		mutex_exit(&(buf_dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 
 		return;
 	}
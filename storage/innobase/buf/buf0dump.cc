@@ -41,11 +41,13 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
 
 enum status_severity {
+	STATUS_VERBOSE,
 	STATUS_INFO,
 	STATUS_ERR
 };
@@ -70,6 +72,27 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/** Access heat of a dumped page. The pages of each buffer pool instance
+are written in order of decreasing heat, and in LRU order within the same
+heat, so that the load reads the hottest pages first. The heat itself is
+not written: the lines stay "space,page", which older servers can load.
+A third field is still accepted when loading. */
+enum buf_dump_heat {
+	/** in the old sublist of the LRU, never accessed (read-ahead) */
+	BUF_DUMP_HEAT_COLD = 0,
+	/** in the old sublist of the LRU, accessed */
+	BUF_DUMP_HEAT_OLD,
+	/** in the young sublist of the LRU */
+	BUF_DUMP_HEAT_YOUNG,
+	/** in the youngest quarter of the young sublist; also assumed
+	for dump files that were written without heat */
+	BUF_DUMP_HEAT_HOT
+};
+
+/** Number of LRU list entries that a buffer pool dump copies while
+holding buf_pool->mutex */
+static const ulint	BUF_DUMP_BATCH = 1024;
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -96,6 +119,13 @@ buf_load_start()
 	os_event_set(srv_buf_dump_event);
 }
 
+/** Wake up the buffer pool dump/load thread after
+innodb_buffer_pool_dump_interval was changed. */
+void buf_dump_interval_changed()
+{
+	os_event_set(srv_buf_dump_event);
+}
+
 /*****************************************************************//**
 Sets the global variable that feeds MySQL's innodb_buffer_pool_dump_status
 to the specified string. The format and the following parameters are the
@@ -124,6 +154,9 @@ buf_dump_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_dump_status;
 		break;
@@ -163,6 +196,9 @@ buf_load_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_load_status;
 		break;
@@ -244,6 +280,20 @@ buf_dump_generate_path(
 	}
 }
 
+/** Determine the access heat of a page for a buffer pool dump.
+@param[in]	bpage	page in buf_pool->LRU
+@return the access heat */
+static buf_dump_heat buf_dump_get_heat(const buf_page_t* bpage)
+{
+	if (bpage->old) {
+		return bpage->access_time
+			? BUF_DUMP_HEAT_OLD : BUF_DUMP_HEAT_COLD;
+	}
+
+	return buf_page_peek_if_young(bpage)
+		? BUF_DUMP_HEAT_HOT : BUF_DUMP_HEAT_YOUNG;
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -254,8 +304,11 @@ static
 void
 buf_dump(
 /*=====*/
-	ibool	obey_shutdown)	/*!< in: quit if we are in a shutting down
+	ibool	obey_shutdown,	/*!< in: quit if we are in a shutting down
 				state */
+	bool	periodic = false)/*!< in: whether this is a periodic dump,
+				whose progress is not written to the
+				error log */
 {
 #define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
 
@@ -265,13 +318,14 @@ buf_dump(
 	FILE*	f;
 	ulint	i;
 	int	ret;
+	const status_severity	info = periodic ? STATUS_VERBOSE : STATUS_INFO;
 
 	buf_dump_generate_path(full_filename, sizeof(full_filename));
 
 	snprintf(tmp_filename, sizeof(tmp_filename),
 		 "%s.incomplete", full_filename);
 
-	buf_dump_status(STATUS_INFO, "Dumping buffer pool(s) to %s",
+	buf_dump_status(info, "Dumping buffer pool(s) to %s",
 			full_filename);
 
 #if defined(__GLIBC__) || defined(__WIN__) || O_CLOEXEC == 0
@@ -301,7 +355,9 @@ buf_dump(
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
 		buf_dump_t*		dump;
+		byte*			heat;
 		ulint			n_pages;
+		ulint			n_scanned;
 		ulint			j;
 
 		buf_pool = buf_pool_from_array(i);
@@ -328,7 +384,7 @@ buf_dump(
 			t_pages = buf_pool->curr_size
 					*  srv_buf_pool_dump_pct / 100;
 			if (n_pages > t_pages) {
-				buf_dump_status(STATUS_INFO,
+				buf_dump_status(info,
 						"Instance " ULINTPF
 						", restricted to " ULINTPF
 						" pages due to "
@@ -344,58 +400,94 @@ buf_dump(
 		}
 
 		dump = static_cast<buf_dump_t*>(ut_malloc_nokey(
-				n_pages * sizeof(*dump)));
+				n_pages * (sizeof(*dump) + sizeof(*heat))));
 
 		if (dump == NULL) {
 			buf_pool_mutex_exit(buf_pool);
 			fclose(f);
 			buf_dump_status(STATUS_ERR,
 					"Cannot allocate " ULINTPF " bytes: %s",
-					(ulint) (n_pages * sizeof(*dump)),
+					(ulint) (n_pages * (sizeof(*dump)
+							    + sizeof(*heat))),
 					strerror(errno));
 			/* leave tmp_filename to exist */
 			return;
 		}
 
-		for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU), j = 0;
-		     bpage != NULL && j < n_pages;
-		     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
+		heat = reinterpret_cast<byte*>(dump + n_pages);
+
+		/* Copy the LRU list BUF_DUMP_BATCH entries at a time,
+		releasing buf_pool->mutex in between. If the next block
+		to copy is removed from the list meanwhile, dump_hp is
+		moved to its predecessor, which was copied already. */
+		for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU), j = 0,
+		     n_scanned = 0;
+		     bpage != NULL && j < n_pages && !SHOULD_QUIT(); ) {
 
 			ut_a(buf_page_in_file(bpage));
-			if (bpage->id.space() >= SRV_LOG_SPACE_FIRST_ID) {
-				/* Ignore the innodb_temporary tablespace. */
-				continue;
+			if (bpage->id.space() < SRV_LOG_SPACE_FIRST_ID) {
+				const buf_dump_t	entry = BUF_DUMP_CREATE(
+					bpage->id.space(),
+					bpage->id.page_no());
+
+				if (j == 0 || dump[j - 1] != entry) {
+					heat[j] = byte(
+						buf_dump_get_heat(bpage));
+					dump[j++] = entry;
+				}
+			}
+			/* else ignore the innodb_temporary tablespace. */
+
+			bpage = UT_LIST_GET_NEXT(LRU, bpage);
+
+			if (++n_scanned % BUF_DUMP_BATCH == 0
+			    && bpage != NULL) {
+				buf_pool->dump_hp.set(
+					const_cast<buf_page_t*>(bpage));
+				buf_pool_mutex_exit(buf_pool);
+				os_thread_yield();
+				buf_pool_mutex_enter(buf_pool);
+				bpage = buf_pool->dump_hp.get();
 			}
-
-			dump[j++] = BUF_DUMP_CREATE(bpage->id.space(),
-						    bpage->id.page_no());
 		}
 
+		buf_pool->dump_hp.set(NULL);
 		buf_pool_mutex_exit(buf_pool);
 
 		ut_a(j <= n_pages);
 		n_pages = j;
 
-		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
-			if (ret < 0) {
-				ut_free(dump);
-				fclose(f);
-				buf_dump_status(STATUS_ERR,
-						"Cannot write to '%s': %s",
-						tmp_filename, strerror(errno));
-				/* leave tmp_filename to exist */
-				return;
-			}
-			if (SHUTTING_DOWN() && !(j % 1024)) {
-				service_manager_extend_timeout(INNODB_EXTEND_TIMEOUT_INTERVAL,
-					"Dumping buffer pool "
-					ULINTPF "/%lu, "
-					"page " ULINTPF "/" ULINTPF,
-					i + 1, srv_buf_pool_instances,
-					j + 1, n_pages);
+		/* Write the hottest pages first. */
+		ulint	n_written = 0;
+
+		for (int h = BUF_DUMP_HEAT_HOT; h >= BUF_DUMP_HEAT_COLD; h--) {
+			for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
+				if (heat[j] != h) {
+					continue;
+				}
+
+				ret = fprintf(f, ULINTPF "," ULINTPF "\n",
+					      BUF_DUMP_SPACE(dump[j]),
+					      BUF_DUMP_PAGE(dump[j]));
+				if (ret < 0) {
+					ut_free(dump);
+					fclose(f);
+					buf_dump_status(STATUS_ERR,
+							"Cannot write to '%s': %s",
+							tmp_filename,
+							strerror(errno));
+					/* leave tmp_filename to exist */
+					return;
+				}
+				if (SHUTTING_DOWN() && !(n_written % 1024)) {
+					service_manager_extend_timeout(INNODB_EXTEND_TIMEOUT_INTERVAL,
+						"Dumping buffer pool "
+						ULINTPF "/%lu, "
+						"page " ULINTPF "/" ULINTPF,
+						i + 1, srv_buf_pool_instances,
+						n_written + 1, n_pages);
+				}
+				n_written++;
 			}
 		}
 
@@ -436,7 +528,7 @@ buf_dump(
 
 	ut_sprintf_timestamp(now);
 
-	buf_dump_status(STATUS_INFO,
+	buf_dump_status(info,
 			"Buffer pool(s) dump completed at %s", now);
 
 	/* Though dumping doesn't related to an incomplete load,
@@ -456,12 +548,15 @@ buf_load_throttle_if_needed(
 	ulint*	last_check_time,	/*!< in/out: milliseconds since epoch
 					of the last time we did check if
 					throttling is needed, we do the check
-					every srv_io_capacity IO ops. */
+					every io_capacity IO ops. */
 	ulint*	last_activity_count,
-	ulint	n_io)			/*!< in: number of IO ops done since
+	ulint	n_io,			/*!< in: number of IO ops done since
 					buffer pool load has started */
+	ulint	io_capacity)		/*!< in: IO ops per second allowed
+					for this thread when the server is
+					busy */
 {
-	if (n_io % srv_io_capacity < srv_io_capacity - 1) {
+	if (n_io % io_capacity < io_capacity - 1) {
 		return;
 	}
 
@@ -471,8 +566,8 @@ buf_load_throttle_if_needed(
 		return;
 	}
 
-	/* srv_io_capacity IO operations have been performed by buffer pool
-	load since the last time we were here. */
+	/* io_capacity IO operations have been performed by this buffer pool
+	load thread since the last time we were here. */
 
 	/* If no other activity, then keep going without any delay. */
 	if (srv_get_activity_count() == *last_activity_count) {
@@ -485,19 +580,19 @@ buf_load_throttle_if_needed(
 	ulint	elapsed_time = now - *last_check_time;
 
 	/* Notice that elapsed_time is not the time for the last
-	srv_io_capacity IO operations performed by BP load. It is the
+	io_capacity IO operations performed by BP load. It is the
 	time elapsed since the last time we detected that there has been
 	other activity. This has a small and acceptable deficiency, e.g.:
 	1. BP load runs and there is no other activity.
 	2. Other activity occurs, we run N IO operations after that and
-	   enter here (where 0 <= N < srv_io_capacity).
+	   enter here (where 0 <= N < io_capacity).
 	3. last_check_time is very old and we do not sleep at this time, but
 	   only update last_check_time and last_activity_count.
-	4. We run srv_io_capacity more IO operations and call this function
+	4. We run io_capacity more IO operations and call this function
 	   again.
 	5. There has been more other activity and thus we enter here.
 	6. Now last_check_time is recent and we sleep if necessary to prevent
-	   more than srv_io_capacity IO operations per second.
+	   more than io_capacity IO operations per second.
 	The deficiency is that we could have slept at 3., but for this we
 	would have to update last_check_time before the
 	"cur_activity_count == *last_activity_count" check and calling
@@ -511,6 +606,245 @@ buf_load_throttle_if_needed(
 	*last_activity_count = srv_get_activity_count();
 }
 
+/** Number of dump entries that are sorted together by physical location.
+The dump lists the pages of each buffer pool instance by decreasing heat,
+and in LRU order within the same heat. Entries are grouped into bands by
+their position in the dump of their instance, and each band is loaded before the next
+one, so that the hottest pages become available first. */
+static const ulint	BUF_LOAD_BAND = 65536;
+
+/** Number of dump entries that a buffer pool load thread claims at a time */
+static const ulint	BUF_LOAD_CHUNK = 256;
+
+/** Read an entry of a buffer pool dump file.
+@param[in,out]	f		dump file
+@param[out]	space_id	tablespace identifier
+@param[out]	page_no		page number
+@param[out]	heat		access heat; BUF_DUMP_HEAT_HOT if the
+				entry does not specify it
+@return number of fields read, as in fscanf(3)
+@retval 2 or 3 on success */
+static int buf_load_read_entry(FILE* f, ulint* space_id, ulint* page_no,
+			       ulint* heat)
+{
+	int	ret = fscanf(f, ULINTPF "," ULINTPF, space_id, page_no);
+
+	if (ret != 2) {
+		return ret;
+	}
+
+	int	c = getc(f);
+
+	if (c != ',') {
+		if (c != EOF) {
+			ungetc(c, f);
+		}
+
+		*heat = BUF_DUMP_HEAT_HOT;
+		return ret;
+	}
+
+	return fscanf(f, ULINTPF, heat) == 1 ? 3 : 0;
+}
+
+/** Order a buffer pool dump for loading: by decreasing heat, by LRU
+band, and by (space, page) within each band.
+@param[in,out]	dump	the dump; replaced with a newly allocated array
+@param[in]	heat	access heat of each entry of dump
+@param[in]	n	number of entries in dump */
+static void buf_load_sort(buf_dump_t*& dump, const byte* heat, ulint n)
+{
+	const ulint	band_size = std::max<ulint>(
+		BUF_LOAD_BAND / srv_buf_pool_instances, 1);
+	uint32_t*	band = static_cast<uint32_t*>(
+		ut_malloc_nokey(n * sizeof *band));
+	buf_dump_t*	sorted = static_cast<buf_dump_t*>(
+		ut_malloc_nokey(n * sizeof *sorted));
+
+	if (!band || !sorted) {
+		/* Fall back to a plain (space, page) order. */
+		ut_free(band);
+		ut_free(sorted);
+		std::sort(dump, dump + n);
+		return;
+	}
+
+	ulint	rank[MAX_BUFFER_POOLS] = {0};
+	ulint	n_bands = 0;
+
+	for (ulint i = 0; i < n; i++) {
+		const buf_pool_t* buf_pool = buf_pool_get(
+			page_id_t(BUF_DUMP_SPACE(dump[i]),
+				  BUF_DUMP_PAGE(dump[i])));
+		band[i] = uint32_t(rank[buf_pool_index(buf_pool)]++
+				   / band_size);
+		n_bands = std::max<ulint>(n_bands, band[i] + 1);
+	}
+
+	/* Hotter entries go to lower bands. */
+	for (ulint i = 0; i < n; i++) {
+		band[i] += uint32_t((BUF_DUMP_HEAT_HOT - heat[i]) * n_bands);
+	}
+
+	n_bands *= BUF_DUMP_HEAT_HOT + 1;
+
+	std::vector<ulint>	first(n_bands + 1);
+
+	for (ulint i = 0; i < n; i++) {
+		first[band[i] + 1]++;
+	}
+
+	for (ulint b = 0; b < n_bands; b++) {
+		first[b + 1] += first[b];
+	}
+
+	std::vector<ulint>	pos(first);
+
+	for (ulint i = 0; i < n; i++) {
+		sorted[pos[band[i]]++] = dump[i];
+	}
+
+	for (ulint b = 0; b < n_bands; b++) {
+		std::sort(sorted + first[b], sorted + first[b + 1]);
+	}
+
+	ut_free(band);
+	ut_free(dump);
+	dump = sorted;
+}
+
+/** State of a buffer pool load that is shared by the loading threads */
+struct buf_load_t {
+	/** the pages to load, see buf_load_sort() */
+	const buf_dump_t*	dump;
+	/** number of entries in dump[] */
+	ulint			n;
+	/** IO ops per second allowed for each thread when the server
+	is busy, see buf_load_throttle_if_needed() */
+	ulint			io_capacity;
+	/** the first entry of the next chunk to be claimed */
+	Atomic_counter<ulint>	next;
+	/** number of processed entries */
+	Atomic_counter<ulint>	done;
+};
+
+/** Load chunks of a buffer pool dump until the dump is exhausted, the
+load is aborted or the server is shutting down.
+@param[in,out]	load		the buffer pool load
+@param[in]	report		whether to update the progress counters */
+static void buf_load_pages(buf_load_t* load, bool report)
+{
+	const buf_dump_t*	dump = load->dump;
+	ulint		last_check_time = 0;
+	ulint		last_activity_cnt = 0;
+	ulint		n_io = 0;
+	ulint		cur_space_id = ULINT_UNDEFINED;
+	fil_space_t*	space = NULL;
+	ulint		zip_size = 0;
+
+	while (!SHUTTING_DOWN() && !buf_load_abort_flag) {
+		const ulint	end = load->next += BUF_LOAD_CHUNK;
+		const ulint	start = end - BUF_LOAD_CHUNK;
+
+		if (start >= load->n) {
+			break;
+		}
+
+		const ulint	n = std::min(end, load->n);
+
+		for (ulint i = start; i < n && !buf_load_abort_flag; i++) {
+			const ulint	this_space_id = BUF_DUMP_SPACE(dump[i]);
+
+#ifdef UNIV_DEBUG
+			if (load->done++ + 1 >= srv_buf_pool_load_pages_abort) {
+				buf_load_abort_flag = 1;
+			}
+#else
+			load->done++;
+#endif
+
+			if (this_space_id >= SRV_LOG_SPACE_FIRST_ID) {
+				/* Ignore the innodb_temporary tablespace. */
+				continue;
+			}
+
+			if (this_space_id != cur_space_id) {
+				if (space != NULL) {
+					space->release();
+				}
+
+				cur_space_id = this_space_id;
+				space = fil_space_acquire_silent(cur_space_id);
+
+				/* JAN: TODO: As we use background page read
+				below, if tablespace is encrypted we cant use
+				it. */
+				if (space != NULL && space->crypt_data
+				    && space->crypt_data->encryption
+				    != FIL_ENCRYPTION_OFF
+				    && space->crypt_data->type
+				    != CRYPT_SCHEME_UNENCRYPTED) {
+					space->release();
+					space = NULL;
+				}
+
+				if (space != NULL) {
+					zip_size = space->zip_size();
+				}
+			}
+
+			if (space == NULL) {
+				continue;
+			}
+
+			/* Submit a run of adjacent pages asynchronously,
+			so that the requests can be merged into larger
+			reads, and wait only for the last page of the run. */
+			const bool	last = i + 1 == n
+				|| dump[i + 1] != dump[i] + 1;
+
+			buf_read_page_background(
+				page_id_t(this_space_id,
+					  BUF_DUMP_PAGE(dump[i])),
+				zip_size, last);
+
+			if (last) {
+				os_aio_simulated_wake_handler_threads();
+			}
+
+			buf_load_throttle_if_needed(
+				&last_check_time, &last_activity_cnt, n_io++,
+				load->io_capacity);
+		}
+
+		if (report) {
+			export_vars.innodb_buffer_pool_load_pages_loaded
+				= load->done;
+		}
+	}
+
+	if (space != NULL) {
+		space->release();
+	}
+}
+
+/** Thread for loading a part of a buffer pool dump.
+@param[in,out]	arg	buf_load_t
+@return OS_THREAD_DUMMY_RETURN */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_load_thread)(void* arg)
+{
+	my_thread_init();
+
+	buf_load_pages(static_cast<buf_load_t*>(arg), false);
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -526,11 +860,13 @@ buf_load()
 	char		now[32];
 	FILE*		f;
 	buf_dump_t*	dump;
+	byte*		heat;
 	ulint		dump_n;
 	ulint		total_buffer_pools_pages;
 	ulint		i;
 	ulint		space_id;
 	ulint		page_no;
+	ulint		page_heat;
 	int		fscanf_ret;
 
 	/* Ignore any leftovers from before */
@@ -554,13 +890,13 @@ buf_load()
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
-	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
+	while (buf_load_read_entry(f, &space_id, &page_no, &page_heat) >= 2
 	       && !SHUTTING_DOWN()) {
 		dump_n++;
 	}
 
 	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
+		/* buf_load_read_entry() returned < 2 */
 		const char*	what;
 		if (ferror(f)) {
 			what = "reading";
@@ -585,7 +921,7 @@ buf_load()
 
 	if(dump_n != 0) {
 		dump = static_cast<buf_dump_t*>(ut_malloc_nokey(
-				dump_n * sizeof(*dump)));
+				dump_n * (sizeof(*dump) + sizeof(*heat))));
 	} else {
 		fclose(f);
 		ut_sprintf_timestamp(now);
@@ -599,20 +935,22 @@ buf_load()
 		fclose(f);
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
-				dump_n * sizeof(*dump),
+				dump_n * (sizeof(*dump) + sizeof(*heat)),
 				strerror(errno));
 		return;
 	}
 
+	heat = reinterpret_cast<byte*>(dump + dump_n);
+
 	rewind(f);
 
 	export_vars.innodb_buffer_pool_load_incomplete = 1;
 
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
-				    &space_id, &page_no);
+		fscanf_ret = buf_load_read_entry(f, &space_id, &page_no,
+						 &page_heat);
 
-		if (fscanf_ret != 2) {
+		if (fscanf_ret < 2) {
 			if (feof(f)) {
 				break;
 			}
@@ -642,6 +980,7 @@ buf_load()
 		}
 
 		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
+		heat[i] = byte(std::min<ulint>(page_heat, BUF_DUMP_HEAT_HOT));
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
@@ -661,19 +1000,9 @@ buf_load()
 	}
 
 	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
+		buf_load_sort(dump, heat, dump_n);
 	}
 
-	ulint		last_check_time = 0;
-	ulint		last_activity_cnt = 0;
-
-	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
-	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
-
 	/* JAN: TODO: MySQL 5.7 PSI
 #ifdef HAVE_PSI_STAGE_INTERFACE
 	PSI_stage_progress*	pfs_stage_progress
@@ -684,96 +1013,61 @@ buf_load()
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 	*/
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	buf_load_t	load;
+	const ulint	n_threads = std::min<ulint>(
+		srv_buf_pool_load_threads,
+		(dump_n + BUF_LOAD_CHUNK - 1) / BUF_LOAD_CHUNK);
 
-		/* space_id for this iteration of the loop */
-		const ulint	this_space_id = BUF_DUMP_SPACE(dump[i]);
+	load.dump = dump;
+	load.n = dump_n;
+	load.io_capacity = std::max<ulint>(srv_io_capacity / n_threads, 1);
+	load.next = 0;
+	load.done = 0;
 
-		if (this_space_id >= SRV_LOG_SPACE_FIRST_ID) {
-			/* Ignore the innodb_temporary tablespace. */
-			continue;
-		}
+	export_vars.innodb_buffer_pool_load_pages_total = dump_n;
+	export_vars.innodb_buffer_pool_load_pages_loaded = 0;
 
-		if (this_space_id != cur_space_id) {
-			if (space != NULL) {
-				space->release();
-			}
+	/* This thread loads pages as well, and reports the progress. */
+	std::vector<os_thread_id_t>	threads(n_threads - 1);
 
-			cur_space_id = this_space_id;
-			space = fil_space_acquire_silent(cur_space_id);
+	for (ulint t = 0; t < threads.size(); t++) {
+		os_thread_create(buf_load_thread, &load, &threads[t]);
+	}
 
-			if (space != NULL) {
-				zip_size = space->zip_size();
-			}
-		}
+	buf_load_pages(&load, true);
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (space == NULL ||
-		   (space && space->crypt_data &&
-		    space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		    space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
+	for (ulint t = 0; t < threads.size(); t++) {
+		os_thread_join(threads[t]);
+	}
 
-		buf_read_page_background(
-			page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
-			zip_size, true);
+	i = std::min<ulint>(load.done, dump_n);
+	export_vars.innodb_buffer_pool_load_pages_loaded = i;
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
-		}
+	ut_free(dump);
 
-		if (buf_load_abort_flag) {
-			if (space != NULL) {
-				space->release();
-			}
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-			/*
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress,
-			i);
-			*/
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = FALSE;
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = i and
+		end the current stage event. */
+		/*
+		mysql_stage_set_work_estimated(pfs_stage_progress, i);
+		mysql_stage_set_work_completed(pfs_stage_progress, i);
+		*/
 #ifdef HAVE_PSI_STAGE_INTERFACE
-			/* mysql_end_stage(); */
+		/* mysql_end_stage(); */
 #endif /* HAVE_PSI_STAGE_INTERFACE */
-			return;
-		}
-
-		buf_load_throttle_if_needed(
-			&last_check_time, &last_activity_cnt, i);
-
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = 1;
-		}
-#endif
-	}
-
-	if (space != NULL) {
-		space->release();
+		return;
 	}
 
-	ut_free(dump);
-
 	ut_sprintf_timestamp(now);
 
 	if (i == dump_n) {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load completed at %s", now);
 		export_vars.innodb_buffer_pool_load_incomplete = 0;
-	} else if (!buf_load_abort_flag) {
-		buf_load_status(STATUS_INFO,
-			"Buffer pool(s) load aborted due to user instigated abort at %s",
-			now);
-		/* intentionally don't reset innodb_buffer_pool_load_incomplete
-                   as we don't want a shutdown to save the buffer pool */
 	} else {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load aborted due to shutdown at %s",
@@ -830,7 +1124,20 @@ DECLARE_THREAD(buf_dump_thread)(void*)
 
 	while (!SHUTTING_DOWN()) {
 
-		os_event_wait(srv_buf_dump_event);
+		if (const ulong interval = srv_buf_pool_dump_interval) {
+			if (os_event_wait_time(srv_buf_dump_event,
+					       interval * 1000000)
+			    == OS_SYNC_TIME_EXCEEDED
+			    && !SHUTTING_DOWN()
+			    /* Do not replace the dump with the pages of
+			    an incomplete load. */
+			    && !export_vars.innodb_buffer_pool_load_incomplete) {
+				buf_dump(TRUE /* quit on shutdown */,
+					 true /* periodic */);
+			}
+		} else {
+			os_event_wait(srv_buf_dump_event);
+		}
 
 		if (buf_dump_should_start) {
 			buf_dump_should_start = false;
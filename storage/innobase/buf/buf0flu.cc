@@ -178,6 +178,14 @@ struct page_cleaner_t {
 	page_cleaner_slot_t	slots[MAX_BUFFER_POOLS];
 	bool			is_running;	/*!< false if attempt
 						to shutdown */
+	os_event_t*		lru_events;	/*!< events to wake up the
+						LRU flushing thread of each
+						buffer pool instance, or NULL
+						if !srv_LRU_flush_threads */
+	volatile ulint		n_lru_threads;	/*!< number of LRU flushing
+						threads in existence; while
+						nonzero, the slots are only
+						used for flush_list flushing */
 
 #ifdef UNIV_DEBUG
 	ulint			n_disabled_debug;
@@ -1179,7 +1187,8 @@ buf_flush_page(
 				/* avoiding deadlock possibility involves
 				doublewrite buffer, should flush it, because
 				it might hold the another block->lock. */
-				buf_dblwr_flush_buffered_writes();
+				buf_dblwr_flush_buffered_writes(
+					buf_pool, flush_type);
 			} else {
 				buf_dblwr_sync_datafiles();
 			}
@@ -1832,10 +1841,12 @@ buf_flush_batch(
 	switch (flush_type) {
 	case BUF_FLUSH_LRU:
 		buf_do_LRU_batch(buf_pool, min_n, n);
+		buf_pool->stat.n_pages_flushed_LRU += n->flushed;
 		break;
 	case BUF_FLUSH_LIST:
 		n->flushed = buf_do_flush_list_batch(buf_pool, min_n, lsn_limit);
 		n->evicted = 0;
+		buf_pool->stat.n_pages_flushed_list += n->flushed;
 		break;
 	default:
 		ut_error;
@@ -1925,7 +1936,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2661,9 +2672,163 @@ buf_flush_page_cleaner_init(void)
 
 	ut_d(page_cleaner.n_disabled_debug = 0);
 
+	if (srv_LRU_flush_threads) {
+		page_cleaner.lru_events = static_cast<os_event_t*>(
+			ut_malloc_nokey(srv_buf_pool_instances
+					* sizeof *page_cleaner.lru_events));
+
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			page_cleaner.lru_events[i] = os_event_create(0);
+		}
+	}
+
 	page_cleaner.is_running = true;
 }
 
+/** Notify the page cleaner that a buffer pool instance is running out of
+free blocks.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	empty		whether no free block could be found */
+void
+buf_flush_LRU_notify(const buf_pool_t* buf_pool, bool empty)
+{
+	if (page_cleaner.n_lru_threads) {
+		os_event_t	event
+			= page_cleaner.lru_events[buf_pool->instance_no];
+
+		if (!os_event_is_set(event)) {
+			os_event_set(event);
+		}
+	} else if (empty) {
+		os_event_set(buf_flush_event);
+	}
+}
+
+/** Determine how long the LRU flushing thread of a buffer pool instance
+should sleep before the next batch. The sleep time is shortened while the
+free list is being depleted and lengthened while it stays filled.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	sleep_ms	the previous sleep time, in milliseconds
+@return the next sleep time, in milliseconds */
+static
+ulint
+buf_flush_LRU_sleep_time(const buf_pool_t* buf_pool, ulint sleep_ms)
+{
+	/* This is a dirty read of the free list length. */
+	const ulint	free_len = UT_LIST_GET_LEN(buf_pool->free);
+	const ulint	scan_depth = srv_LRU_scan_depth;
+
+	if (free_len < scan_depth / 100) {
+		/* Nearly out of free blocks: keep flushing. */
+		return(0);
+	} else if (free_len < scan_depth / 20) {
+		return(sleep_ms > 50 ? sleep_ms - 50 : 0);
+	} else if (free_len > scan_depth / 5) {
+		return(std::min<ulint>(sleep_ms + 50, 1000));
+	}
+
+	return(sleep_ms);
+}
+
+/******************************************************************//**
+LRU flushing thread of a buffer pool instance. It keeps the free list
+filled independently of the flush_list flushing done by the
+page_cleaner coordinator and workers.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_LRU_thread)(
+/*=================================*/
+	void*	arg)	/*!< in: buffer pool instance number */
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(page_cleaner_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	const ulint	i = reinterpret_cast<ulint>(arg);
+	buf_pool_t*	buf_pool = buf_pool_from_array(i);
+	os_event_t	event = page_cleaner.lru_events[i];
+	ulint		sleep_ms = 1000;
+
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		int64_t	sig_count = os_event_reset(event);
+
+		if (sleep_ms) {
+			os_event_wait_time_low(event, sleep_ms * 1000,
+					       sig_count);
+		}
+
+		if (srv_shutdown_state != SRV_SHUTDOWN_NONE) {
+			break;
+		}
+
+#ifdef UNIV_DEBUG
+		if (innodb_page_cleaner_disabled_debug) {
+			sleep_ms = 100;
+			continue;
+		}
+#endif /* UNIV_DEBUG */
+
+		ulint	n_flushed = buf_flush_LRU_list(buf_pool);
+
+		if (n_flushed) {
+			buf_flush_stats(0, n_flushed);
+
+			MONITOR_INC_VALUE_CUMULATIVE(
+				MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
+				MONITOR_LRU_BATCH_FLUSH_COUNT,
+				MONITOR_LRU_BATCH_FLUSH_PAGES,
+				n_flushed);
+		}
+
+		sleep_ms = buf_flush_LRU_sleep_time(buf_pool, sleep_ms);
+	}
+
+	mutex_enter(&page_cleaner.mutex);
+	page_cleaner.n_lru_threads--;
+	mutex_exit(&page_cleaner.mutex);
+
+	my_thread_end();
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start the LRU flushing threads, one for each buffer pool instance. */
+static
+void
+buf_flush_LRU_threads_start()
+{
+	ut_ad(page_cleaner.lru_events);
+
+	mutex_enter(&page_cleaner.mutex);
+	page_cleaner.n_lru_threads = srv_buf_pool_instances;
+	mutex_exit(&page_cleaner.mutex);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		os_thread_create(buf_flush_LRU_thread,
+				 reinterpret_cast<void*>(i), NULL);
+	}
+}
+
+/** Wait for the LRU flushing threads to exit at shutdown. */
+static
+void
+buf_flush_LRU_threads_stop()
+{
+	ut_ad(srv_shutdown_state != SRV_SHUTDOWN_NONE);
+
+	while (page_cleaner.n_lru_threads) {
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			os_event_set(page_cleaner.lru_events[i]);
+		}
+
+		os_thread_sleep(10000);
+	}
+}
+
 /**
 Requests for all slots to flush all buffer pool instances.
 @param min_n	wished minimum mumber of blocks flushed
@@ -2772,13 +2937,18 @@ pc_flush_slot(void)
 
 		mutex_exit(&page_cleaner.mutex);
 
-		lru_tm = ut_time_ms();
+		if (page_cleaner.n_lru_threads) {
+			/* buf_flush_LRU_thread() takes care of the LRU */
+			slot->n_flushed_lru = 0;
+		} else {
+			lru_tm = ut_time_ms();
 
-		/* Flush pages from end of LRU if required */
-		slot->n_flushed_lru = buf_flush_LRU_list(buf_pool);
+			/* Flush pages from end of LRU if required */
+			slot->n_flushed_lru = buf_flush_LRU_list(buf_pool);
 
-		lru_tm = ut_time_ms() - lru_tm;
-		lru_pass++;
+			lru_tm = ut_time_ms() - lru_tm;
+			lru_pass++;
+		}
 
 		if (UNIV_UNLIKELY(!page_cleaner.is_running)) {
 			slot->n_flushed_list = 0;
@@ -3075,6 +3245,11 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 
 	os_event_wait(buf_flush_event);
 
+	if (page_cleaner.lru_events
+	    && srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		buf_flush_LRU_threads_start();
+	}
+
 	ulint	ret_sleep = 0;
 	ulint	n_evicted = 0;
 	ulint	n_flushed_last = 0;
@@ -3272,6 +3447,13 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	}
 
 	ut_ad(srv_shutdown_state > 0);
+
+	if (page_cleaner.lru_events) {
+		/* From now on, pc_flush_slot() will flush the LRU lists,
+		for any remaining activity of the master and purge threads. */
+		buf_flush_LRU_threads_stop();
+	}
+
 	if (srv_fast_shutdown == 2
 	    || srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS) {
 		/* In very fast shutdown or when innodb failed to start, we
@@ -3371,6 +3553,15 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	os_event_destroy(page_cleaner.is_requested);
 	os_event_destroy(page_cleaner.is_started);
 
+	if (page_cleaner.lru_events) {
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			os_event_destroy(page_cleaner.lru_events[i]);
+		}
+
+		ut_free(page_cleaner.lru_events);
+		page_cleaner.lru_events = NULL;
+	}
+
 	buf_page_cleaner_is_active = false;
 
 	my_thread_end();
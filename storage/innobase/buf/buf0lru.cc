@@ -1102,8 +1102,17 @@ buf_LRU_get_free_block(
 	block = buf_LRU_get_free_only(buf_pool);
 
 	if (block != NULL) {
+		/* Wake up the LRU flushing thread before the free
+		list runs out. */
+		const bool	low = UT_LIST_GET_LEN(buf_pool->free)
+			< srv_LRU_scan_depth / 20;
 
 		buf_pool_mutex_exit(buf_pool);
+
+		if (low && !srv_read_only_mode) {
+			buf_flush_LRU_notify(buf_pool, false);
+		}
+
 		ut_ad(buf_pool_from_block(block) == buf_pool);
 		memset(&block->page.zip, 0, sizeof block->page.zip);
 
@@ -1132,7 +1141,7 @@ buf_LRU_get_free_block(
 
 			/* Also tell the page_cleaner thread that
 			there is work for it to do. */
-			os_event_set(buf_flush_event);
+			buf_flush_LRU_notify(buf_pool, true);
 		}
 	}
 
@@ -1171,7 +1180,7 @@ buf_LRU_get_free_block(
 	page_cleaner do an LRU batch for us. */
 
 	if (!srv_read_only_mode) {
-		os_event_set(buf_flush_event);
+		buf_flush_LRU_notify(buf_pool, true);
 	}
 
 	if (n_iterations > 1) {
@@ -1341,6 +1350,7 @@ buf_LRU_adjust_hp(
 	buf_pool->lru_hp.adjust(bpage);
 	buf_pool->lru_scan_itr.adjust(bpage);
 	buf_pool->single_scan_itr.adjust(bpage);
+	buf_pool->dump_hp.adjust(bpage);
 }
 
 /******************************************************************//**
@@ -44,6 +44,10 @@ Modified           Jan Lindström jan.lindstrom@mariadb.com
 /** Mutex for keys */
 static ib_mutex_t fil_crypt_key_mutex;
 
+/** How often to ask the encryption plugin for the latest key version
+when encrypting pages, in nanoseconds */
+static const ulonglong FIL_CRYPT_KEY_REFRESH_NS = 1000000000;
+
 static bool fil_crypt_threads_inited = false;
 
 /** Is encryption enabled/disabled */
@@ -144,11 +148,95 @@ fil_space_crypt_t::key_get_latest_version(void)
 		key_version = encryption_key_get_latest_version(key_id);
 		srv_stats.n_key_requests.inc();
 		key_found = key_version;
+		key_checked.store(my_interval_timer(),
+				  std::memory_order_relaxed);
 	}
 
 	return key_version;
 }
 
+/** Get the latest key version for encrypting a page. The
+encryption plugin is consulted at most once per FIL_CRYPT_KEY_REFRESH_NS.
+@param[out]	refreshed	whether the plugin was consulted
+@return key version or ENCRYPTION_KEY_VERSION_INVALID */
+uint
+fil_space_crypt_t::key_get_cached_version(bool* refreshed)
+{
+	const ulonglong	checked = key_checked.load(std::memory_order_relaxed);
+
+	*refreshed = !checked
+		|| my_interval_timer() - checked >= FIL_CRYPT_KEY_REFRESH_NS;
+
+	return *refreshed ? key_get_latest_version() : key_found;
+}
+
+/** Look up the tablespace-local key of a key version.
+The key is read from local_keys[] without acquiring mutex. On a miss,
+it is derived like in the encryption scheme service, by encrypting iv
+with the global key, and added to the cache.
+@param[in]	key_version	key version
+@param[out]	key		tablespace-local key
+@return 0 or error code from encryption_key_get() */
+uint
+fil_space_crypt_t::local_key_get(uint key_version, byte* key)
+{
+	ut_ad(key_version != ENCRYPTION_KEY_VERSION_INVALID);
+	ut_ad(key_version != ENCRYPTION_KEY_NOT_ENCRYPTED);
+
+	for (ulint i = 0; i < UT_ARR_SIZE(local_keys); i++) {
+		local_key_t&	k = local_keys[i];
+		const uint32_t	seq = k.seq.load(std::memory_order_acquire);
+
+		if ((seq & 1)
+		    || k.version.load(std::memory_order_relaxed)
+		    != key_version) {
+			continue;
+		}
+
+		memcpy(key, k.key, MY_AES_BLOCK_SIZE);
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (k.seq.load(std::memory_order_relaxed) == seq) {
+			return 0;
+		}
+	}
+
+	byte	global_key[MY_AES_MAX_KEY_LENGTH];
+	uint	global_key_len = sizeof global_key;
+
+	if (uint rc = encryption_key_get(key_id, key_version,
+					 global_key, &global_key_len)) {
+		return rc;
+	}
+
+	uint	key_len;
+	int	err = my_aes_crypt(MY_AES_ECB,
+				   ENCRYPTION_FLAG_ENCRYPT
+				   | ENCRYPTION_FLAG_NOPAD,
+				   iv, sizeof iv, key, &key_len,
+				   global_key, global_key_len, NULL, 0);
+
+	if (err != MY_AES_OK) {
+		return uint(err);
+	}
+
+	ut_ad(key_len == MY_AES_BLOCK_SIZE);
+
+	mutex_enter(&mutex);
+	keyserver_requests++;
+
+	local_key_t&	k = local_keys[local_key_next++
+				       % UT_ARR_SIZE(local_keys)];
+	k.seq.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	k.version.store(key_version, std::memory_order_relaxed);
+	memcpy(k.key, key, MY_AES_BLOCK_SIZE);
+	k.seq.fetch_add(1, std::memory_order_release);
+
+	mutex_exit(&mutex);
+	return 0;
+}
+
 /******************************************************************
 Get the latest(key-version), waking the encrypt thread, if needed
 @param[in,out]	crypt_data	Crypt data */
@@ -159,9 +247,10 @@ fil_crypt_get_latest_key_version(
 {
 	ut_ad(crypt_data != NULL);
 
-	uint key_version = crypt_data->key_get_latest_version();
+	bool refreshed;
+	uint key_version = crypt_data->key_get_cached_version(&refreshed);
 
-	if (crypt_data->is_key_found()) {
+	if (refreshed && crypt_data->is_key_found()) {
 
 		if (fil_crypt_needs_rotation(
 				crypt_data,
@@ -180,6 +269,56 @@ fil_crypt_get_latest_key_version(
 	return key_version;
 }
 
+/** Encrypt or decrypt a page payload with the tablespace-local key.
+This is equivalent to encryption_scheme_encrypt() and
+encryption_scheme_decrypt(), but it avoids acquiring crypt_data->mutex
+for every page.
+@param[in]	src		source data
+@param[in]	srclen		length of source data
+@param[out]	dst		destination buffer
+@param[out]	dstlen		length of the output
+@param[in,out]	crypt_data	tablespace encryption parameters
+@param[in]	key_version	key version
+@param[in]	space		tablespace identifier
+@param[in]	offset		page number
+@param[in]	lsn		page LSN
+@param[in]	flags		ENCRYPTION_FLAG_ENCRYPT or ENCRYPTION_FLAG_DECRYPT
+@return MY_AES_OK or error code */
+static int
+fil_crypt_page_crypt(
+	const byte*		src,
+	uint			srclen,
+	byte*			dst,
+	uint*			dstlen,
+	fil_space_crypt_t*	crypt_data,
+	uint			key_version,
+	uint			space,
+	uint			offset,
+	lsn_t			lsn,
+	int			flags)
+{
+	if (key_version == ENCRYPTION_KEY_VERSION_INVALID
+	    || key_version == ENCRYPTION_KEY_NOT_ENCRYPTED) {
+		return ENCRYPTION_SCHEME_KEY_INVALID;
+	}
+
+	byte	key[MY_AES_BLOCK_SIZE];
+
+	if (uint rc = crypt_data->local_key_get(key_version, key)) {
+		return int(rc);
+	}
+
+	/* Same IV layout as in the encryption scheme service */
+	byte	iv[4 + 4 + 8];
+	int4store(iv + 0, space);
+	int4store(iv + 4, offset);
+	int8store(iv + 8, lsn);
+
+	return encryption_crypt(src, srclen, dst, dstlen, key, sizeof key,
+				iv, sizeof iv, flags | ENCRYPTION_FLAG_NOPAD,
+				crypt_data->key_id, key_version);
+}
+
 /******************************************************************
 Mutex helper for crypt_data->scheme */
 void
@@ -556,9 +695,10 @@ static byte* fil_encrypt_buf_for_non_full_checksum(
 		srclen = mach_read_from_2(src_frame + FIL_PAGE_DATA);
 	}
 
-	int rc = encryption_scheme_encrypt(src, srclen, dst, &dstlen,
-					   crypt_data, key_version,
-					   (uint32)space, (uint32)offset, lsn);
+	int rc = fil_crypt_page_crypt(src, srclen, dst, &dstlen,
+				      crypt_data, key_version,
+				      (uint32)space, (uint32)offset, lsn,
+				      ENCRYPTION_FLAG_ENCRYPT);
 	ut_a(rc == MY_AES_OK);
 	ut_a(dstlen == srclen);
 
@@ -630,9 +770,10 @@ static byte* fil_encrypt_buf_for_full_crc32(
 	/* Write key version to the page. */
 	mach_write_to_4(dst_frame + FIL_PAGE_FCRC32_KEY_VERSION, key_version);
 
-	int rc = encryption_scheme_encrypt(src, srclen, dst, &dstlen,
-					   crypt_data, key_version,
-					   uint(space), uint(offset), lsn);
+	int rc = fil_crypt_page_crypt(src, srclen, dst, &dstlen,
+				      crypt_data, key_version,
+				      uint(space), uint(offset), lsn,
+				      ENCRYPTION_FLAG_ENCRYPT);
 	ut_a(rc == MY_AES_OK);
 	ut_a(dstlen == srclen);
 
@@ -839,9 +980,10 @@ static bool fil_space_decrypt_full_crc32(
 	uint srclen = size - (FIL_PAGE_FILE_FLUSH_LSN_OR_KEY_VERSION
 			      + FIL_PAGE_FCRC32_CHECKSUM);
 
-	int rc = encryption_scheme_decrypt(src, srclen, dst, &dstlen,
-					   crypt_data, key_version,
-					   (uint) space, offset, lsn);
+	int rc = fil_crypt_page_crypt(src, srclen, dst, &dstlen,
+				      crypt_data, key_version,
+				      (uint) space, offset, lsn,
+				      ENCRYPTION_FLAG_DECRYPT);
 
 	if (rc != MY_AES_OK || dstlen != srclen) {
 		if (rc == -1) {
@@ -917,9 +1059,10 @@ static bool fil_space_decrypt_for_non_full_checksum(
 		srclen = mach_read_from_2(src_frame + FIL_PAGE_DATA);
 	}
 
-	int rc = encryption_scheme_decrypt(src, srclen, dst, &dstlen,
-					   crypt_data, key_version,
-					   space, offset, lsn);
+	int rc = fil_crypt_page_crypt(src, srclen, dst, &dstlen,
+				      crypt_data, key_version,
+				      space, offset, lsn,
+				      ENCRYPTION_FLAG_DECRYPT);
 
 	if (! ((rc == MY_AES_OK) && ((ulint) dstlen == srclen))) {
 
@@ -1292,7 +1435,13 @@ struct rotate_thread_t {
 
 	uint thread_no;
 	bool first;		    /*!< is position before first space */
+	bool joined;		    /*!< whether space was joined by
+				    fil_crypt_join_rotating_space() */
 	fil_space_t* space;	    /*!< current space or NULL */
+	fil_space_t* rotating;	    /*!< space being rotated, published
+				    for other threads to join; protected
+				    by fil_crypt_threads_mutex */
+	rotate_thread_t* next;	    /*!< next in fil_crypt_threads_list */
 	ulint offset;		    /*!< current offset */
 	ulint batch;		    /*!< #pages to rotate */
 	uint  min_key_version_found;/*!< min key version found but not rotated */
@@ -1326,6 +1475,20 @@ struct rotate_thread_t {
 	}
 };
 
+/** Running key rotation threads, protected by fil_crypt_threads_mutex */
+static rotate_thread_t* fil_crypt_threads_list;
+
+/** Publish or retract the tablespace that a thread is rotating.
+@param[in,out]	state	rotation thread state
+@param[in]	space	tablespace being rotated, or NULL */
+static void fil_crypt_set_rotating(rotate_thread_t* state, fil_space_t* space)
+{
+	ut_ad(!space || space == state->space);
+	mutex_enter(&fil_crypt_threads_mutex);
+	state->rotating = space;
+	mutex_exit(&fil_crypt_threads_mutex);
+}
+
 /***********************************************************************
 Check if space needs rotation given a key_state
 @param[in,out]		state		Key rotation state
@@ -1448,6 +1611,7 @@ fil_crypt_update_total_stat(
 		state->crypt_stat.pages_read_from_disk;
 	crypt_stat.pages_modified += state->crypt_stat.pages_modified;
 	crypt_stat.pages_flushed += state->crypt_stat.pages_flushed;
+	crypt_stat.threads_joined += state->crypt_stat.threads_joined;
 	// remote old estimate
 	crypt_stat.estimated_iops -= state->crypt_stat.estimated_iops;
 	// add new estimate
@@ -1623,6 +1787,103 @@ fil_crypt_return_iops(
 	fil_crypt_update_total_stat(state);
 }
 
+/** Minimum number of pages left to rotate for another thread to
+join the key rotation of a tablespace */
+static const ulint FIL_CRYPT_JOIN_MIN_PAGES = 1024;
+
+/** Join the ongoing key rotation that has the most pages left, so that
+a large tablespace is not left to a single thread while the other
+threads iterate over small tablespaces.
+@param[in,out]	key_state	Key state
+@param[in,out]	state		Rotation state
+@return whether a tablespace was joined */
+static bool fil_crypt_join_rotating_space(
+	key_state_t*		key_state,
+	rotate_thread_t*	state)
+{
+	/* The joined tablespace would become the iteration position.
+	Only fil_space_next() can continue from an arbitrary position. */
+	if (!srv_fil_crypt_rotate_key_age) {
+		return false;
+	}
+
+	fil_space_t*	space = NULL;
+	ulint		max_left = std::max<ulint>(
+		FIL_CRYPT_JOIN_MIN_PAGES,
+		2 * srv_alloc_time * state->allocated_iops);
+
+	mutex_enter(&fil_crypt_threads_mutex);
+
+	for (rotate_thread_t* t = fil_crypt_threads_list; t; t = t->next) {
+		fil_space_t* s = t->rotating;
+
+		if (!s || t == state || s == state->space
+		    || s->is_stopping() || !s->crypt_data) {
+			continue;
+		}
+
+		/* Read without crypt_data->mutex; the choice is
+		validated below. */
+		const fil_space_rotate_state_t& r = s->crypt_data->rotate_state;
+
+		if (r.max_offset > r.next_offset
+		    && r.max_offset - r.next_offset > max_left) {
+			max_left = r.max_offset - r.next_offset;
+			space = s;
+		}
+	}
+
+	if (space) {
+		/* t->rotating holds a reference until it is reset
+		while holding fil_crypt_threads_mutex. */
+		space->acquire();
+	}
+
+	mutex_exit(&fil_crypt_threads_mutex);
+
+	if (!space) {
+		return false;
+	}
+
+	fil_space_crypt_t* crypt_data = space->crypt_data;
+
+	mutex_enter(&crypt_data->mutex);
+
+	const bool join = !space->is_stopping()
+		&& crypt_data->rotate_state.active_threads > 0
+		&& !crypt_data->rotate_state.flushing
+		&& crypt_data->rotate_state.max_offset
+		> crypt_data->rotate_state.next_offset;
+
+	if (join) {
+		crypt_data->rotate_state.active_threads++;
+		state->end_lsn = crypt_data->rotate_state.end_lsn;
+		state->min_key_version_found =
+			crypt_data->rotate_state.min_key_version_found;
+		crypt_data->rotate_state.scrubbing.is_active =
+			btr_scrub_start_space(space->id, &state->scrub_data);
+	}
+
+	mutex_exit(&crypt_data->mutex);
+
+	if (!join) {
+		space->release();
+		return false;
+	}
+
+	key_state->key_id = crypt_data->key_id;
+	fil_crypt_get_key_state(key_state, crypt_data);
+
+	if (state->space) {
+		state->space->release();
+	}
+
+	state->space = space;
+	state->joined = true;
+	state->crypt_stat.threads_joined++;
+	return true;
+}
+
 /** Search for a space needing rotation
 @param[in,out]	key_state	Key state
 @param[in,out]	state		Rotation state
@@ -1655,6 +1916,10 @@ static bool fil_crypt_find_space_to_rotate(
 		state->space = NULL;
 	}
 
+	if (fil_crypt_join_rotating_space(key_state, state)) {
+		return true;
+	}
+
 	/* If key rotation is enabled (default) we iterate all tablespaces.
 	If key rotation is not enabled we iterate only the tablespaces
 	added to keyrotation list. */
@@ -2318,6 +2583,11 @@ DECLARE_THREAD(fil_crypt_thread)(void*)
 	/* state of this thread */
 	rotate_thread_t thr(thread_no);
 
+	mutex_enter(&fil_crypt_threads_mutex);
+	thr.next = fil_crypt_threads_list;
+	fil_crypt_threads_list = &thr;
+	mutex_exit(&fil_crypt_threads_mutex);
+
 	/* if we find a space that is starting, skip over it and recheck it later */
 	bool recheck = false;
 
@@ -2365,7 +2635,13 @@ DECLARE_THREAD(fil_crypt_thread)(void*)
 		       fil_crypt_find_space_to_rotate(&new_state, &thr, &recheck)) {
 
 			/* we found a space to rotate */
-			fil_crypt_start_rotate_space(&new_state, &thr);
+			if (thr.joined) {
+				thr.joined = false;
+			} else {
+				fil_crypt_start_rotate_space(&new_state, &thr);
+			}
+
+			fil_crypt_set_rotating(&thr, thr.space);
 
 			/* iterate all pages (cooperativly with other threads) */
 			while (!thr.should_shutdown() &&
@@ -2379,6 +2655,7 @@ DECLARE_THREAD(fil_crypt_thread)(void*)
 				/* If space is marked as stopping, release
 				space and stop rotation. */
 				if (thr.space->is_stopping()) {
+					fil_crypt_set_rotating(&thr, NULL);
 					fil_crypt_complete_rotate_space(&thr);
 					thr.space->release();
 					thr.space = NULL;
@@ -2391,6 +2668,7 @@ DECLARE_THREAD(fil_crypt_thread)(void*)
 
 			/* complete rotation */
 			if (thr.space) {
+				fil_crypt_set_rotating(&thr, NULL);
 				fil_crypt_complete_rotate_space(&thr);
 			}
 
@@ -2412,6 +2690,16 @@ DECLARE_THREAD(fil_crypt_thread)(void*)
 	}
 
 	mutex_enter(&fil_crypt_threads_mutex);
+	ut_ad(!thr.rotating);
+
+	for (rotate_thread_t** t = &fil_crypt_threads_list; *t;
+	     t = &(*t)->next) {
+		if (*t == &thr) {
+			*t = thr.next;
+			break;
+		}
+	}
+
 	srv_n_fil_crypt_threads_started--;
 	os_event_set(fil_crypt_event); /* signal that we stopped */
 	mutex_exit(&fil_crypt_threads_mutex);
@@ -2690,6 +2978,7 @@ fil_space_crypt_get_status(
 	}
 
 	status->space = ULINT_UNDEFINED;
+	status->rotate_seconds_left = ULINT_UNDEFINED;
 
 	if (fil_space_crypt_t* crypt_data = space->crypt_data) {
 		status->space = space->id;
@@ -2708,6 +2997,25 @@ fil_space_crypt_get_status(
 				crypt_data->rotate_state.next_offset;
 			status->rotate_max_page_number =
 				crypt_data->rotate_state.max_offset;
+
+			/* Extrapolate from the progress so far. Page 0
+			is not rotated by the threads, and next_offset
+			is 0 before the first batch was handed out. */
+			const fil_space_rotate_state_t& r
+				= crypt_data->rotate_state;
+			const ulint pos = std::min(r.next_offset,
+						   r.max_offset);
+			const ulint done = pos ? pos - 1 : 0;
+			const time_t elapsed = time(NULL) - r.start_time;
+
+			if (r.flushing || r.next_offset >= r.max_offset) {
+				status->rotate_seconds_left = 0;
+			} else if (done && elapsed > 0) {
+				status->rotate_seconds_left = ulint(
+					double(elapsed)
+					* double(r.max_offset - r.next_offset)
+					/ double(done));
+			}
 		}
 
 		mutex_exit(&crypt_data->mutex);
@@ -73,20 +73,162 @@ Updated 14/02/2015
 #include "snappy-c.h"
 #endif
 
+/** Reusable zlib state for page_compressed compression */
+struct fil_comp_ctx_t
+{
+	/** zlib deflate stream; zlib.state is NULL if not initialized */
+	z_stream	zlib;
+	/** compression level that zlib was initialized with */
+	int		zlib_level;
+};
+
+/** Maximum number of compression contexts (the maximum of
+innodb_page_cleaners). Each holds a deflate state of about 256 KiB. */
+static const ulint	FIL_COMP_CTX_MAX = 64;
+
+/** Idle compression contexts */
+static std::atomic<fil_comp_ctx_t*>	fil_comp_ctx_pool[FIL_COMP_CTX_MAX];
+
+/** Number of compression contexts that exist, idle or in use */
+static std::atomic<ulint>		fil_comp_ctx_n;
+
+/** Take a compression context from the pool. At most one context per
+page cleaner thread is created. Beyond that, the caller compresses
+without a context, setting up a state for the page only.
+@return compression context
+@retval NULL if none is available */
+static fil_comp_ctx_t* fil_comp_ctx_acquire()
+{
+	for (ulint i = 0; i < FIL_COMP_CTX_MAX; i++) {
+		if (fil_comp_ctx_pool[i].load(std::memory_order_relaxed)) {
+			if (fil_comp_ctx_t* ctx = fil_comp_ctx_pool[i].exchange(
+				    NULL, std::memory_order_acquire)) {
+				return ctx;
+			}
+		}
+	}
+
+	const ulint	limit = std::min<ulint>(srv_n_page_cleaners,
+						FIL_COMP_CTX_MAX);
+	ulint		n = fil_comp_ctx_n.load(std::memory_order_relaxed);
+
+	do {
+		if (n >= limit) {
+			return NULL;
+		}
+	} while (!fil_comp_ctx_n.compare_exchange_weak(
+			 n, n + 1, std::memory_order_relaxed));
+
+	return static_cast<fil_comp_ctx_t*>(ut_zalloc_nokey(sizeof
+							   (fil_comp_ctx_t)));
+}
+
+/** Free a compression context.
+@param[in,out]	ctx	compression context */
+static void fil_comp_ctx_free(fil_comp_ctx_t* ctx)
+{
+	if (ctx->zlib.state) {
+		deflateEnd(&ctx->zlib);
+	}
+
+	ut_free(ctx);
+	fil_comp_ctx_n.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/** Return a compression context to the pool. If innodb_page_cleaners
+was reduced, the context is freed instead.
+@param[in,out]	ctx	compression context */
+static void fil_comp_ctx_release(fil_comp_ctx_t* ctx)
+{
+	if (fil_comp_ctx_n.load(std::memory_order_relaxed)
+	    <= srv_n_page_cleaners) {
+		for (ulint i = 0; i < FIL_COMP_CTX_MAX; i++) {
+			fil_comp_ctx_t*	empty = NULL;
+
+			if (fil_comp_ctx_pool[i].compare_exchange_strong(
+				    empty, ctx, std::memory_order_release,
+				    std::memory_order_relaxed)) {
+				return;
+			}
+		}
+	}
+
+	fil_comp_ctx_free(ctx);
+}
+
+/** Free the idle compression contexts at shutdown. */
+void fil_comp_ctx_pool_free()
+{
+	for (ulint i = 0; i < FIL_COMP_CTX_MAX; i++) {
+		if (fil_comp_ctx_t* ctx = fil_comp_ctx_pool[i].exchange(
+			    NULL, std::memory_order_acquire)) {
+			fil_comp_ctx_free(ctx);
+		}
+	}
+
+	ut_ad(!fil_comp_ctx_n);
+}
+
+/** Compress a page with zlib, reusing the deflate stream of a context.
+The output is identical to that of compress2().
+@param[in]	buf		page to be compressed
+@param[out]	out		compressed data
+@param[in]	out_len		size of out
+@param[in]	comp_level	compression level
+@param[in,out]	ctx		compression context
+@return length of the compressed data
+@retval 0 if the page was not compressed */
+static ulint fil_page_compress_zlib(
+	const byte*	buf,
+	byte*		out,
+	ulint		out_len,
+	ulint		comp_level,
+	fil_comp_ctx_t*	ctx)
+{
+	z_stream&	s = ctx->zlib;
+
+	if (s.state && ctx->zlib_level != int(comp_level)) {
+		deflateEnd(&s);
+	}
+
+	if (!s.state) {
+		s.zalloc = Z_NULL;
+		s.zfree = Z_NULL;
+		s.opaque = Z_NULL;
+
+		if (deflateInit(&s, int(comp_level)) != Z_OK) {
+			return 0;
+		}
+
+		ctx->zlib_level = int(comp_level);
+	} else if (deflateReset(&s) != Z_OK) {
+		return 0;
+	}
+
+	s.next_in = const_cast<Bytef*>(buf);
+	s.avail_in = uInt(srv_page_size);
+	s.next_out = out;
+	s.avail_out = uInt(out_len);
+
+	return deflate(&s, Z_FINISH) == Z_STREAM_END ? s.total_out : 0;
+}
+
 /** Compress a page for the given compression algorithm.
 @param[in]	buf		page to be compressed
 @param[out]	out_buf		compressed page
 @param[in]	header_len	header length of the page
 @param[in]	comp_algo	compression algorithm
 @param[in]	comp_level	compression level
+@param[in,out]	ctx		compression context, or NULL
 @return actual length of compressed page data
 @retval 0 if the page was not compressed */
-static ulint fil_page_compress_low(
+static ulint fil_page_compress_algo(
 	const byte*	buf,
 	byte*		out_buf,
 	ulint		header_len,
 	ulint		comp_algo,
-	ulint		comp_level)
+	ulint		comp_level,
+	fil_comp_ctx_t*	ctx)
 {
 	ulint write_size = srv_page_size - header_len;
 
@@ -97,6 +239,12 @@ static ulint fil_page_compress_low(
 	case PAGE_UNCOMPRESSED:
 		return 0;
 	case PAGE_ZLIB_ALGORITHM:
+		if (ctx) {
+			return fil_page_compress_zlib(
+				buf, out_buf + header_len, write_size,
+				comp_level, ctx);
+		}
+
 		{
 			ulong len = uLong(write_size);
 			if (Z_OK == compress2(
@@ -138,6 +286,8 @@ static ulint fil_page_compress_low(
 #endif /* HAVE_LZO */
 #ifdef HAVE_LZMA
 	case PAGE_LZMA_ALGORITHM: {
+		/* An lzma encoder takes tens of megabytes. It is not
+		kept between pages. */
 		size_t out_pos = 0;
 
 		if (LZMA_OK == lzma_easy_buffer_encode(
@@ -187,6 +337,45 @@ static ulint fil_page_compress_low(
 	return 0;
 }
 
+/** Compress a page for the given compression algorithm, and account
+for it in the per-algorithm statistics.
+@param[in]	buf		page to be compressed
+@param[out]	out_buf		compressed page
+@param[in]	header_len	header length of the page
+@param[in]	comp_algo	compression algorithm
+@param[in]	comp_level	compression level
+@return actual length of compressed page data
+@retval 0 if the page was not compressed */
+static ulint fil_page_compress_low(
+	const byte*	buf,
+	byte*		out_buf,
+	ulint		header_len,
+	ulint		comp_algo,
+	ulint		comp_level)
+{
+	const ulonglong	start = my_interval_timer();
+	fil_comp_ctx_t*	ctx = comp_algo == PAGE_ZLIB_ALGORITHM
+		? fil_comp_ctx_acquire() : NULL;
+	const ulint	len = fil_page_compress_algo(
+		buf, out_buf, header_len, comp_algo, comp_level, ctx);
+
+	if (ctx) {
+		fil_comp_ctx_release(ctx);
+	}
+
+	if (comp_algo <= PAGE_ALGORITHM_LAST) {
+		srv_stats.page_compression_time[comp_algo].add(
+			int64_t(my_interval_timer() - start));
+
+		if (len) {
+			srv_stats.page_compression_pages[comp_algo].inc();
+			srv_stats.page_compression_bytes[comp_algo].add(len);
+		}
+	}
+
+	return len;
+}
+
 /** Compress a page_compressed page for full crc32 format.
 @param[in]	buf		page to be compressed
 @param[out]	out_buf		compressed page
@@ -434,7 +623,7 @@ ulint fil_page_compress(
 @param[in]	header_len	header length of the page
 @param[in]	actual size	actual size of the page
 @retval true if the page is decompressed or false */
-static bool fil_page_decompress_low(
+static bool fil_page_decompress_algo(
 	byte*		tmp_buf,
 	byte*		buf,
 	ulint		comp_algo,
@@ -515,6 +704,34 @@ static bool fil_page_decompress_low(
 	return false;
 }
 
+/** Decompress a page that may be subject to page_compressed compression,
+and account for it in the per-algorithm statistics.
+@param[in,out]	tmp_buf		temporary buffer (of innodb_page_size)
+@param[in,out]	buf		possibly compressed page buffer
+@param[in]	comp_algo	compression algorithm
+@param[in]	header_len	header length of the page
+@param[in]	actual size	actual size of the page
+@retval true if the page is decompressed or false */
+static bool fil_page_decompress_low(
+	byte*		tmp_buf,
+	byte*		buf,
+	ulint		comp_algo,
+	ulint		header_len,
+	ulint		actual_size)
+{
+	const ulonglong	start = my_interval_timer();
+	const bool	success = fil_page_decompress_algo(
+		tmp_buf, buf, comp_algo, header_len, actual_size);
+
+	if (success && comp_algo <= PAGE_ALGORITHM_LAST) {
+		srv_stats.page_decompression_time[comp_algo].add(
+			int64_t(my_interval_timer() - start));
+		srv_stats.page_decompression_pages[comp_algo].inc();
+	}
+
+	return success;
+}
+
 /** Decompress a page for full crc32 format.
 @param[in,out]	tmp_buf	temporary buffer (of innodb_page_size)
 @param[in,out]	buf	possibly compressed page buffer
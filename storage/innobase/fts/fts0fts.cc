@@ -62,6 +62,9 @@ bool	fts_need_sync = false;
 /** Variable specifying the total memory allocated for FTS cache */
 ulong	fts_max_total_cache_size;
 
+/** Number of threads for tokenizing inserted documents at commit */
+ulong	fts_commit_threads;
+
 /** This is FTS result cache limit for each query and would be
 a configurable variable */
 size_t	fts_result_cache_limit;
@@ -286,6 +289,8 @@ static
 void
 fts_cache_destroy(fts_cache_t* cache)
 {
+	srv_stats.fts_cache_size.add(-int64_t(cache->total_size));
+
 	rw_lock_free(&cache->lock);
 	rw_lock_free(&cache->init_lock);
 	mutex_free(&cache->optimize_lock);
@@ -1118,6 +1123,7 @@ fts_cache_clear(
 
 	fts_need_sync = false;
 
+	srv_stats.fts_cache_size.add(-int64_t(cache->total_size));
 	cache->total_size = 0;
 
 	mutex_enter((ib_mutex_t*) &cache->deleted_lock);
@@ -1376,6 +1382,8 @@ fts_cache_add_doc(
 
 	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
 
+	const ulint	size = cache->total_size;
+
 	n_words = rbt_size(tokens);
 
 	for (node = rbt_first(tokens); node; node = rbt_first(tokens)) {
@@ -1428,6 +1436,8 @@ fts_cache_add_doc(
 	/* Add the doc stats memory usage too. */
 	cache->total_size += sizeof(*doc_stats);
 
+	srv_stats.fts_cache_size.add(int64_t(cache->total_size - size));
+
 	if (doc_id > cache->sync->max_doc_id) {
 		cache->sync->max_doc_id = doc_id;
 	}
@@ -2976,6 +2986,100 @@ fts_modify(
 	return(error);
 }
 
+/** Minimum number of inserted documents for fts_commit_table() to
+tokenize them in fts_commit_threads threads */
+static const ulint FTS_PARALLEL_ADD_MIN_ROWS = 256;
+
+/** Documents to be added to the FTS cache by several threads */
+struct fts_add_batch_t {
+	fts_trx_table_t*	ftt;	/*!< FTS trx table */
+	fts_trx_row_t**		rows;	/*!< inserted rows */
+	ulint			n_rows;	/*!< number of rows */
+	Atomic_counter<ulint>	next;	/*!< next row to add */
+};
+
+/** Add documents to the FTS cache until the batch is exhausted.
+The documents are fetched and tokenized concurrently; only the
+insertion into the FTS cache is serialized by cache->lock.
+@param[in,out]	batch	documents to add */
+static void fts_add_batch(fts_add_batch_t* batch)
+{
+	for (ulint i; (i = batch->next++) < batch->n_rows; ) {
+		const fts_trx_row_t* row = batch->rows[i];
+		ut_ad(row->state == FTS_INSERT);
+		fts_add_doc_by_id(batch->ftt, row->doc_id, row->fts_indexes);
+	}
+}
+
+/** Thread for adding documents to the FTS cache.
+@param[in,out]	arg	fts_add_batch_t
+@return OS_THREAD_DUMMY_RETURN */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(fts_add_thread)(void* arg)
+{
+	my_thread_init();
+	fts_add_batch(static_cast<fts_add_batch_t*>(arg));
+	my_thread_end();
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Add the documents inserted by a transaction to the FTS cache.
+@param[in,out]	ftt	FTS trx table
+@param[in]	rows	inserted rows, in ascending order of doc id */
+static void fts_add_rows(
+	fts_trx_table_t*			ftt,
+	const std::vector<fts_trx_row_t*>&	rows)
+{
+	if (fts_commit_threads <= 1
+	    || rows.size() < FTS_PARALLEL_ADD_MIN_ROWS) {
+		for (ulint i = 0; i < rows.size(); i++) {
+			fts_add(ftt, rows[i]);
+		}
+
+		return;
+	}
+
+	/* The first document initializes the stopword list and the
+	FTS index cache if needed. */
+	fts_add(ftt, rows[0]);
+
+	const ulint n_threads = ut_min(
+		ulint(fts_commit_threads),
+		rows.size() / (FTS_PARALLEL_ADD_MIN_ROWS / 2));
+
+	fts_add_batch_t	batch;
+	batch.ftt = ftt;
+	batch.rows = const_cast<fts_trx_row_t**>(&rows[0]);
+	batch.n_rows = rows.size() - 1;
+	batch.next = 1;
+
+	std::vector<os_thread_id_t>	threads(n_threads - 1);
+
+	for (ulint i = 0; i < threads.size(); i++) {
+		os_thread_create(fts_add_thread, &batch, &threads[i]);
+	}
+
+	fts_add_batch(&batch);
+
+	for (ulint i = 0; i < threads.size(); i++) {
+		os_thread_join(threads[i]);
+	}
+
+	fts_cache_t*	cache = ftt->table->fts->cache;
+
+	mutex_enter(&cache->deleted_lock);
+	cache->added += batch.n_rows - 1;
+	mutex_exit(&cache->deleted_lock);
+
+	/* The last document has the largest doc id; fts_add() will
+	advance cache->next_doc_id past it. */
+	fts_add(ftt, rows.back());
+}
+
 /*********************************************************************//**
 The given transaction is about to be committed; do whatever is necessary
 from the FTS system's POV.
@@ -3010,6 +3114,11 @@ fts_commit_table(
 		rw_lock_x_unlock(&cache->init_lock);
 	}
 
+	/* Inserted documents are tokenized and added to the cache
+	after the other rows have been processed. The documents
+	are independent of each other. */
+	std::vector<fts_trx_row_t*>	inserted;
+
 	for (node = rbt_first(rows);
 	     node != NULL && error == DB_SUCCESS;
 	     node = rbt_next(rows, node)) {
@@ -3018,7 +3127,7 @@ fts_commit_table(
 
 		switch (row->state) {
 		case FTS_INSERT:
-			fts_add(ftt, row);
+			inserted.push_back(row);
 			break;
 
 		case FTS_MODIFY:
@@ -3034,6 +3143,10 @@ fts_commit_table(
 		}
 	}
 
+	if (error == DB_SUCCESS) {
+		fts_add_rows(ftt, inserted);
+	}
+
 	fts_sql_commit(trx);
 
 	trx_free(trx);
@@ -4280,6 +4393,7 @@ fts_sync(
 	ulint		i;
 	dberr_t		error = DB_SUCCESS;
 	fts_cache_t*	cache = sync->table->fts->cache;
+	bool		first_pass = true;
 
 	rw_lock_x_lock(&cache->lock);
 
@@ -4301,6 +4415,8 @@ fts_sync(
 	sync->unlock_cache = unlock_cache;
 	sync->in_progress = true;
 
+	const ulonglong	start = my_interval_timer();
+
 	DEBUG_SYNC_C("fts_sync_begin");
 	fts_sync_begin(sync);
 
@@ -4311,13 +4427,18 @@ fts_sync(
 	}
 
 begin_sync:
-	if (cache->total_size > fts_max_cache_size) {
-		/* Avoid the case: sync never finish when
-		insert/update keeps comming. */
-		ut_ad(sync->unlock_cache);
+	/* Write out the words that are in the cache now while allowing
+	concurrent inserts. If the cache is still too large after that,
+	keep it locked, so that the sync will finish even if inserts and
+	updates keep coming. */
+	if (!first_pass && sync->unlock_cache
+	    && cache->total_size > fts_max_cache_size) {
 		sync->unlock_cache = false;
+		srv_stats.fts_sync_stalls.inc();
 	}
 
+	first_pass = false;
+
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
 		fts_index_cache_t*	index_cache;
 
@@ -4383,6 +4504,9 @@ fts_sync(
 	os_event_set(sync->event);
 	rw_lock_x_unlock(&cache->lock);
 
+	srv_stats.fts_syncs.inc();
+	srv_stats.fts_sync_time.add(int64_t(my_interval_timer() - start));
+
 	/* We need to check whether an optimize is required, for that
 	we make copies of the two variables that control the trigger. These
 	variables can change behind our back and we don't want to hold the
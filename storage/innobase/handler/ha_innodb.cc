@@ -117,6 +117,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 extern "C" void thd_mark_transaction_to_rollback(MYSQL_THD thd, bool all);
 unsigned long long thd_get_query_id(const MYSQL_THD thd);
+unsigned long long thd_select_limit(const MYSQL_THD thd);
 TABLE *find_fk_open_table(THD *thd, const char *db, size_t db_len,
 			  const char *table, size_t table_len);
 MYSQL_THD create_thd();
@@ -605,6 +606,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
 	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_shard_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -950,6 +952,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_buffer_pool_resize_status,  SHOW_CHAR},
   {"buffer_pool_load_incomplete",
   &export_vars.innodb_buffer_pool_load_incomplete,        SHOW_BOOL},
+  {"buffer_pool_load_pages_loaded",
+  (char*) &export_vars.innodb_buffer_pool_load_pages_loaded, SHOW_LONG},
+  {"buffer_pool_load_pages_total",
+  (char*) &export_vars.innodb_buffer_pool_load_pages_total, SHOW_LONG},
   {"buffer_pool_pages_data",
   (char*) &export_vars.innodb_buffer_pool_pages_data,	  SHOW_LONG},
   {"buffer_pool_bytes_data",
@@ -1004,6 +1010,32 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_dblwr_pages_written,	  SHOW_LONG},
   {"dblwr_writes",
   (char*) &export_vars.innodb_dblwr_writes,		  SHOW_LONG},
+  {"deadlock_detect_cycles",
+  (char*) &export_vars.innodb_deadlock_detect_cycles,	  SHOW_LONG},
+  {"deadlock_detect_latency_avg",
+  (char*) &export_vars.innodb_deadlock_detect_latency_avg, SHOW_LONG},
+  {"deadlock_detect_latency_max",
+  (char*) &export_vars.innodb_deadlock_detect_latency_max, SHOW_LONG},
+  {"deadlock_detect_snapshot_time",
+  (char*) &export_vars.innodb_deadlock_detect_snapshot_time, SHOW_LONGLONG},
+  {"deadlock_detect_snapshots",
+  (char*) &export_vars.innodb_deadlock_detect_snapshots, SHOW_LONG},
+  {"ft_cache_size",
+  (char*) &export_vars.innodb_ft_cache_size,		  SHOW_LONGLONG},
+  {"ft_sync_stalls",
+  (char*) &export_vars.innodb_ft_sync_stalls,		  SHOW_LONG},
+  {"ft_sync_time",
+  (char*) &export_vars.innodb_ft_sync_time,		  SHOW_LONGLONG},
+  {"ft_syncs",
+  (char*) &export_vars.innodb_ft_syncs,		  SHOW_LONG},
+  {"log_flusher_batch_bytes",
+  (char*) &export_vars.innodb_log_flusher_batch_bytes,	  SHOW_LONGLONG},
+  {"log_flusher_batches",
+  (char*) &export_vars.innodb_log_flusher_batches,	  SHOW_LONG},
+  {"log_flusher_wait_time",
+  (char*) &export_vars.innodb_log_flusher_wait_time,	  SHOW_LONGLONG},
+  {"log_flusher_waits",
+  (char*) &export_vars.innodb_log_flusher_waits,	  SHOW_LONG},
   {"log_waits",
   (char*) &export_vars.innodb_log_waits,		  SHOW_LONG},
   {"log_write_requests",
@@ -1026,6 +1058,18 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_pages_read,		  SHOW_LONG},
   {"pages_written",
   (char*) &export_vars.innodb_pages_written,		  SHOW_LONG},
+  {"purge_lag_records",
+  (char*) &export_vars.innodb_purge_lag_records,	  SHOW_LONG},
+  {"purge_lag_seconds",
+  (char*) &export_vars.innodb_purge_lag_seconds,	  SHOW_LONG},
+  {"purge_records",
+  (char*) &export_vars.innodb_purge_records,		  SHOW_LONG},
+  {"purge_threads_active",
+  (char*) &export_vars.innodb_purge_threads_active,	  SHOW_LONG},
+  {"read_view_snapshots",
+  (char*) &export_vars.innodb_read_view_snapshots,	  SHOW_LONG},
+  {"read_views_reused",
+  (char*) &export_vars.innodb_read_views_reused,	  SHOW_LONG},
   {"row_lock_current_waits",
   (char*) &export_vars.innodb_row_lock_current_waits,	  SHOW_LONG},
   {"row_lock_time",
@@ -1076,6 +1120,24 @@ static SHOW_VAR innodb_status_variables[]= {
    (char*) &export_vars.innodb_pages_page_decompressed,   SHOW_LONGLONG},
   {"num_pages_page_compression_error",
    (char*) &export_vars.innodb_pages_page_compression_error,   SHOW_LONGLONG},
+#define PAGE_COMPRESSION_STATUS(name, algo)				\
+  {"page_compression_" name "_pages",					\
+   (char*) &export_vars.innodb_page_compression_pages[algo], SHOW_LONG},\
+  {"page_compression_" name "_bytes",					\
+   (char*) &export_vars.innodb_page_compression_bytes[algo], SHOW_LONG},\
+  {"page_compression_" name "_time",					\
+   (char*) &export_vars.innodb_page_compression_time[algo], SHOW_LONGLONG},\
+  {"page_decompression_" name "_pages",				\
+   (char*) &export_vars.innodb_page_decompression_pages[algo], SHOW_LONG},\
+  {"page_decompression_" name "_time",					\
+   (char*) &export_vars.innodb_page_decompression_time[algo], SHOW_LONGLONG}
+  PAGE_COMPRESSION_STATUS("zlib", PAGE_ZLIB_ALGORITHM),
+  PAGE_COMPRESSION_STATUS("lz4", PAGE_LZ4_ALGORITHM),
+  PAGE_COMPRESSION_STATUS("lzo", PAGE_LZO_ALGORITHM),
+  PAGE_COMPRESSION_STATUS("lzma", PAGE_LZMA_ALGORITHM),
+  PAGE_COMPRESSION_STATUS("bzip2", PAGE_BZIP2_ALGORITHM),
+  PAGE_COMPRESSION_STATUS("snappy", PAGE_SNAPPY_ALGORITHM),
+#undef PAGE_COMPRESSION_STATUS
   {"num_pages_encrypted",
    (char*) &export_vars.innodb_pages_encrypted,   SHOW_LONGLONG},
   {"num_pages_decrypted",
@@ -1135,6 +1197,9 @@ static SHOW_VAR innodb_status_variables[]= {
   {"encryption_rotation_estimated_iops",
   (char*) &export_vars.innodb_encryption_rotation_estimated_iops,
    SHOW_LONG},
+  {"encryption_rotation_threads_joined",
+  (char*) &export_vars.innodb_encryption_rotation_threads_joined,
+   SHOW_LONG},
   {"encryption_key_rotation_list_length",
   (char*)&export_vars.innodb_key_rotation_list_length,
    SHOW_LONGLONG},
@@ -9128,6 +9193,8 @@ ha_innobase::index_init(
 {
 	DBUG_ENTER("index_init");
 
+	m_prebuilt->fetch_cache_scan_rows = 0;
+
 	DBUG_RETURN(change_active_index(keynr));
 }
 
@@ -9779,11 +9846,29 @@ ha_innobase::rnd_init(
 		try_semi_consistent_read(0);
 	}
 
+	/* A table scan is likely to read many rows; let
+	row_search_mvcc() prefetch them in large batches. */
+	m_prebuilt->fetch_cache_scan_rows = scan ? scan_rows_hint() : 0;
+
 	m_start_of_scan = true;
 
 	return(err);
 }
 
+/** Estimate how many rows a table scan will return, so that
+row_search_mvcc() does not prefetch many more rows than are needed.
+A LIMIT is only taken into account if the rows are not sorted or
+grouped first.
+@return estimated number of rows */
+ulint
+ha_innobase::scan_rows_hint() const
+{
+	ha_rows	rows = std::min<ha_rows>(stats.records,
+					 thd_select_limit(ha_thd()));
+
+	return(ulint(std::min<ha_rows>(rows, ULINT_MAX)));
+}
+
 /*****************************************************************//**
 Ends a table scan.
 @return 0 or error number */
@@ -15296,6 +15381,12 @@ ha_innobase::extra(
 	case HA_EXTRA_KEYREAD_PRESERVE_FIELDS:
 		m_prebuilt->keep_other_fields_on_keyread = 1;
 		break;
+	case HA_EXTRA_CACHE:
+		m_prebuilt->fetch_cache_scan_rows = scan_rows_hint();
+		break;
+	case HA_EXTRA_NO_CACHE:
+		m_prebuilt->fetch_cache_scan_rows = 0;
+		break;
 
 		/* IMPORTANT: m_prebuilt->trx can be obsolete in
 		this method, because it is not sure that MySQL
@@ -18429,6 +18520,22 @@ buffer_pool_dump_now(
 	}
 }
 
+/** Update innodb_buffer_pool_dump_interval.
+@param[in]	save	to-be-assigned value */
+static
+void
+innodb_buffer_pool_dump_interval_update(THD*, st_mysql_sys_var*, void*,
+					const void* save)
+{
+	srv_buf_pool_dump_interval = *static_cast<const ulong*>(save);
+
+	if (!srv_read_only_mode) {
+		mysql_mutex_unlock(&LOCK_global_system_variables);
+		buf_dump_interval_changed();
+		mysql_mutex_lock(&LOCK_global_system_variables);
+	}
+}
+
 /****************************************************************//**
 Trigger a load of the buffer pool if innodb_buffer_pool_load_now is set
 to ON. This function is registered as a callback with MySQL. */
@@ -18816,6 +18923,20 @@ static MYSQL_SYSVAR_BOOL(doublewrite, srv_use_doublewrite_buf,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(parallel_doublewrite, srv_parallel_doublewrite,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write the doublewrite copies of LRU and flush list batches to a file"
+  " per buffer pool instance (ib_dblwr0, ib_dblwr1, ...) instead of the"
+  " system tablespace, so that the batches can be written in parallel",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONG(parallel_doublewrite_batch_size,
+  srv_parallel_doublewrite_batch_size,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of pages written to the parallel doublewrite file"
+  " in one sequential write",
+  NULL, NULL, 128, 16, 1024, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, innobase_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -18885,6 +19006,14 @@ static MYSQL_SYSVAR_ULONG(purge_batch_size, srv_purge_batch_size,
   1,			/* Minimum value */
   5000, 0);		/* Maximum value */
 
+static MYSQL_SYSVAR_ULONG(purge_history_per_thread,
+  srv_purge_history_per_thread,
+  PLUGIN_VAR_RQCMDARG,
+  "Length of the history list per active purge thread."
+  " 0 (the default) adjusts the number of active purge threads"
+  " by the growth of the history list.",
+  NULL, NULL, 0, 0, ULONG_MAX, 0);
+
 static MYSQL_SYSVAR_ULONG(purge_threads, srv_n_purge_threads,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Purge threads can be from 1 to 32. Default is 4.",
@@ -19101,6 +19230,14 @@ static MYSQL_SYSVAR_ULONG(adaptive_hash_index_parts, btr_ahi_parts,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Number of InnoDB Adaptive Hash Index Partitions (default 8)",
   NULL, NULL, 8, 1, 512, 0);
+
+static MYSQL_SYSVAR_ULONG(adaptive_hash_index_min_hit_pct,
+  btr_search_min_hit_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "Stop building adaptive hash index entries for an index whose"
+  " hash search hit ratio is below this percentage"
+  " (0 by default, disabling the check)",
+  NULL, NULL, 0, 0, 100, 0);
 #endif /* BTR_CUR_HASH_ADAPT */
 
 static MYSQL_SYSVAR_ULONG(replication_delay, srv_replication_delay,
@@ -19224,6 +19361,12 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_dump_interval, srv_buf_pool_dump_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Dump the buffer pool every N seconds, so that a recent dump is available"
+  " after a crash; 0 (the default) disables periodic dumps",
+  NULL, innodb_buffer_pool_dump_interval_update, 0, 0, 86400, 0);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19247,6 +19390,11 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_abort, innodb_buffer_pool_load_abort,
   "Abort a currently running load of the buffer pool",
   NULL, buffer_pool_load_abort, FALSE);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_pool_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for loading the buffer pool from a file named @@innodb_buffer_pool_filename",
+  NULL, NULL, 4, 1, 64, 0);
+
 /* there is no point in changing this during runtime, thus readonly */
 static MYSQL_SYSVAR_BOOL(buffer_pool_load_at_startup, srv_buffer_pool_load_at_startup,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
@@ -19312,6 +19460,12 @@ static MYSQL_SYSVAR_ULONG(lru_scan_depth, srv_LRU_scan_depth,
   "How deep to scan LRU to keep it clean",
   NULL, NULL, 1024, 100, ~0UL, 0);
 
+static MYSQL_SYSVAR_BOOL(lru_flush_threads, srv_LRU_flush_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use a dedicated LRU flushing thread for each buffer pool instance,"
+  " running concurrently with the flush list flushing of the page cleaners",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(flush_neighbors, srv_flush_neighbors,
   PLUGIN_VAR_OPCMDARG,
   "Set to 0 (don't flush neighbors from buffer pool),"
@@ -19337,6 +19491,14 @@ static MYSQL_SYSVAR_BOOL(deadlock_detect, innobase_deadlock_detect,
   " and we rely on innodb_lock_wait_timeout in case of deadlock.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(deadlock_detect_interval,
+  innodb_deadlock_detect_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Milliseconds between searches of the wait-for graph of all lock waits"
+  " by a background thread. 0 (the default) checks for deadlocks in each"
+  " transaction that starts a lock wait.",
+  NULL, NULL, 0, 0, 1000, 0);
+
 static MYSQL_SYSVAR_UINT(fill_factor, innobase_fill_factor,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of B-tree page filled during bulk insert",
@@ -19387,6 +19549,12 @@ static MYSQL_SYSVAR_ULONG(ft_num_word_optimize, fts_num_word_optimize,
   "InnoDB Fulltext search number of words to optimize for each optimize table call ",
   NULL, NULL, 2000, 1000, 10000, 0);
 
+static MYSQL_SYSVAR_ULONG(ft_commit_threads, fts_commit_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for tokenizing the FULLTEXT documents inserted by"
+  " a committing transaction",
+  NULL, NULL, 1, 1, 16, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_sort_pll_degree, fts_sort_pll_degree,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search parallel sort degree, will round up to nearest power of 2 number",
@@ -19397,6 +19565,18 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(alter_scan_threads, srv_alter_scan_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for reading the clustered index when adding"
+  " secondary indexes without rebuilding the table",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(alter_build_threads, srv_alter_build_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of secondary indexes to sort and load concurrently when adding"
+  " them without rebuilding the table; each uses 3 sort buffers",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19412,6 +19592,11 @@ static MYSQL_SYSVAR_ULONG(read_io_threads, srv_n_read_io_threads,
   "Number of background read I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(log_apply_threads, srv_n_log_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying the redo log to data pages during crash recovery.",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(write_io_threads, srv_n_write_io_threads,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Number of background write I/O threads in InnoDB.",
@@ -19452,6 +19637,12 @@ static MYSQL_SYSVAR_ULONG(log_write_ahead_size, srv_log_write_ahead_size,
   NULL, innodb_log_write_ahead_size_update,
   8*1024L, OS_FILE_LOG_BLOCK_SIZE, UNIV_PAGE_SIZE_DEF, OS_FILE_LOG_BLOCK_SIZE);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Whether to write and flush the redo log in dedicated background threads"
+  " that group the requests of committing transactions",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_UINT(old_blocks_pct, innobase_old_blocks_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of the buffer pool to reserve for 'old' blocks.",
@@ -19964,6 +20155,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_dump_interval),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -19973,12 +20165,14 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_load_pages_abort),
 #endif /* UNIV_DEBUG */
   MYSQL_SYSVAR(buffer_pool_load_at_startup),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
   MYSQL_SYSVAR(defragment),
   MYSQL_SYSVAR(defragment_n_pages),
   MYSQL_SYSVAR(defragment_stats_accuracy),
   MYSQL_SYSVAR(defragment_fill_factor),
   MYSQL_SYSVAR(defragment_fill_factor_n_recs),
   MYSQL_SYSVAR(defragment_frequency),
+  MYSQL_SYSVAR(lru_flush_threads),
   MYSQL_SYSVAR(lru_scan_depth),
   MYSQL_SYSVAR(flush_neighbors),
   MYSQL_SYSVAR(checksum_algorithm),
@@ -19991,6 +20185,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite_batch_size),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
@@ -20004,6 +20200,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(force_recovery),
   MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(ft_cache_size),
+  MYSQL_SYSVAR(ft_commit_threads),
   MYSQL_SYSVAR(ft_total_cache_size),
   MYSQL_SYSVAR(ft_result_cache_limit),
   MYSQL_SYSVAR(ft_enable_stopword),
@@ -20017,11 +20214,14 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(deadlock_detect_interval),
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
+  MYSQL_SYSVAR(log_apply_threads),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_write_ahead_size),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(log_group_home_dir),
   MYSQL_SYSVAR(log_compressed_pages),
   MYSQL_SYSVAR(log_optimize_ddl),
@@ -20054,12 +20254,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #ifdef BTR_CUR_HASH_ADAPT
   MYSQL_SYSVAR(adaptive_hash_index),
   MYSQL_SYSVAR(adaptive_hash_index_parts),
+  MYSQL_SYSVAR(adaptive_hash_index_min_hit_pct),
 #endif /* BTR_CUR_HASH_ADAPT */
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(alter_scan_threads),
+  MYSQL_SYSVAR(alter_build_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -20097,6 +20300,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(monitor_reset_all),
   MYSQL_SYSVAR(purge_threads),
   MYSQL_SYSVAR(purge_batch_size),
+  MYSQL_SYSVAR(purge_history_per_thread),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(background_drop_list_empty),
   MYSQL_SYSVAR(log_checkpoint_now),
@@ -20212,6 +20416,9 @@ i_s_innodb_sys_datafiles,
 i_s_innodb_sys_virtual,
 i_s_innodb_mutexes,
 i_s_innodb_sys_semaphore_waits,
+#ifdef BTR_CUR_HASH_ADAPT
+i_s_innodb_ahi_partitions,
+#endif /* BTR_CUR_HASH_ADAPT */
 i_s_innodb_tablespaces_encryption,
 i_s_innodb_tablespaces_scrubbing
 maria_declare_plugin_end;
@@ -459,6 +459,7 @@ class ha_innobase: public handler
 
 	int general_fetch(uchar* buf, uint direction, uint match_mode);
 	int change_active_index(uint keynr);
+	ulint scan_rows_hint() const;
 	dict_index_t* innobase_get_index(uint keynr);
 
 #ifdef WITH_WSREP
@@ -53,6 +53,7 @@ Modified Dec 29, 2014 Jan Lindström (Added sys_semaphore_waits)
 #include "fts0opt.h"
 #include "fts0priv.h"
 #include "btr0btr.h"
+#include "btr0sea.h"
 #include "page0zip.h"
 #include "sync0arr.h"
 #include "fil0fil.h"
@@ -4327,6 +4328,42 @@ static ST_FIELD_INFO	i_s_innodb_buffer_stats_fields_info[] =
 	 STRUCT_FLD(old_name,		""),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
+#define IDX_BUF_STATS_PAGE_FLUSHED_LRU	32
+	{STRUCT_FLD(field_name,		"NUMBER_PAGES_FLUSHED_LRU"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_BUF_STATS_PAGE_FLUSHED_LIST	33
+	{STRUCT_FLD(field_name,		"NUMBER_PAGES_FLUSHED_LIST"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define	IDX_BUF_STATS_PAGE_FLUSHED_LRU_RATE	34
+	{STRUCT_FLD(field_name,		"PAGES_FLUSHED_LRU_RATE"),
+	 STRUCT_FLD(field_length,	MAX_FLOAT_STR_LENGTH),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_FLOAT),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define	IDX_BUF_STATS_PAGE_FLUSHED_LIST_RATE	35
+	{STRUCT_FLD(field_name,		"PAGES_FLUSHED_LIST_RATE"),
+	 STRUCT_FLD(field_length,	MAX_FLOAT_STR_LENGTH),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_FLOAT),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
 	END_OF_ST_FIELD_INFO
 };
 
@@ -4462,6 +4499,18 @@ i_s_innodb_stats_fill(
 	OK(fields[IDX_BUF_STATS_UNZIP_CUR]->store(
 		   info->unzip_cur, true));
 
+	OK(fields[IDX_BUF_STATS_PAGE_FLUSHED_LRU]->store(
+		   info->n_pages_flushed_LRU, true));
+
+	OK(fields[IDX_BUF_STATS_PAGE_FLUSHED_LIST]->store(
+		   info->n_pages_flushed_list, true));
+
+	OK(fields[IDX_BUF_STATS_PAGE_FLUSHED_LRU_RATE]->store(
+		   info->pages_flushed_LRU_rate));
+
+	OK(fields[IDX_BUF_STATS_PAGE_FLUSHED_LIST_RATE]->store(
+		   info->pages_flushed_list_rate));
+
 	DBUG_RETURN(schema_table_store_record(thd, table));
 }
 
@@ -8485,6 +8534,15 @@ static ST_FIELD_INFO	innodb_tablespaces_encryption_fields_info[] =
 	 STRUCT_FLD(old_name,		""),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_SECONDS_LEFT 10
+	{STRUCT_FLD(field_name,		"KEY_ROTATION_SECONDS_LEFT"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
 	END_OF_ST_FIELD_INFO
 };
 
@@ -8549,6 +8607,16 @@ i_s_dict_fill_tablespaces_encryption(
 			->set_null();
 	}
 
+	if (status.rotate_seconds_left != ULINT_UNDEFINED) {
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_SECONDS_LEFT]
+			->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_SECONDS_LEFT]
+		   ->store(status.rotate_seconds_left, true));
+	} else {
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_SECONDS_LEFT]
+			->set_null();
+	}
+
 	OK(schema_table_store_record(thd, table_to_fill));
 
 skip:
@@ -9435,3 +9503,186 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_sys_semaphore_waits =
 	STRUCT_FLD(version_info, INNODB_VERSION_STR),
         STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
 };
+
+#ifdef BTR_CUR_HASH_ADAPT
+/**  INNODB_ADAPTIVE_HASH_PARTITIONS  ***********************************/
+/* Fields of the dynamic table
+INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS */
+static ST_FIELD_INFO	innodb_ahi_partitions_fields_info[] =
+{
+#define AHI_PARTITION_ID		0
+	{STRUCT_FLD(field_name,		"PARTITION_ID"),
+	 STRUCT_FLD(field_length,	MY_INT32_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+#define AHI_PARTITION_CELLS		1
+	{STRUCT_FLD(field_name,		"HASH_TABLE_SIZE"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+#define AHI_PARTITION_HEAP_PAGES	2
+	{STRUCT_FLD(field_name,		"HEAP_PAGES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+#define AHI_PARTITION_MEMORY		3
+	{STRUCT_FLD(field_name,		"MEMORY"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+#define AHI_PARTITION_HITS		4
+	{STRUCT_FLD(field_name,		"HITS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+#define AHI_PARTITION_MISSES		5
+	{STRUCT_FLD(field_name,		"MISSES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+/*******************************************************************//**
+Function to populate INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS.
+@return 0 on success */
+static
+int
+i_s_innodb_ahi_partitions_fill_table(
+/*=================================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (not used) */
+{
+	Field**		fields = tables->table->field;
+
+	DBUG_ENTER("i_s_innodb_ahi_partitions_fill_table");
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* deny access to user without PROCESS_ACL privilege */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+	for (ulint i = 0; i < btr_ahi_parts; i++) {
+		rw_lock_t*	latch = btr_search_s_lock(
+			btr_search_latches[i]);
+		const hash_table_t* table = btr_search_sys->hash_tables[i];
+		const ulint	n_cells = table->n_cells;
+		const ulint	n_pages = table->heap->base.count
+			- !table->heap->free_block;
+		rw_lock_s_unlock(latch);
+
+		ulint		n_hits = 0;
+		ulint		n_misses = 0;
+
+		for (ulint j = 0; j < BTR_SEARCH_N_SLOTS; j++) {
+			const btr_search_slot_t* slot = btr_search_slot(
+				btr_search_latches[i], j);
+			n_hits += slot->n_hits;
+			n_misses += slot->n_misses;
+		}
+
+		OK(fields[AHI_PARTITION_ID]->store(i, true));
+		OK(fields[AHI_PARTITION_CELLS]->store(n_cells, true));
+		OK(fields[AHI_PARTITION_HEAP_PAGES]->store(n_pages, true));
+		OK(fields[AHI_PARTITION_MEMORY]->store(
+			   n_cells * sizeof(hash_cell_t)
+			   + n_pages * srv_page_size, true));
+		OK(fields[AHI_PARTITION_HITS]->store(n_hits, true));
+		OK(fields[AHI_PARTITION_MISSES]->store(n_misses, true));
+		OK(schema_table_store_record(thd, tables->table));
+	}
+
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS
+@return 0 on success */
+static
+int
+innodb_ahi_partitions_init(
+/*=======================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("innodb_ahi_partitions_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = innodb_ahi_partitions_fields_info;
+	schema->fill_table = i_s_innodb_ahi_partitions_fill_table;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_ahi_partitions =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_ADAPTIVE_HASH_PARTITIONS"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, maria_plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB adaptive hash index partitions"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, innodb_ahi_partitions_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+	/* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+	STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
+};
+#endif /* BTR_CUR_HASH_ADAPT */
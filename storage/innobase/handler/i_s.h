@@ -65,6 +65,9 @@ extern struct st_maria_plugin	i_s_innodb_sys_virtual;
 extern struct st_maria_plugin	i_s_innodb_tablespaces_encryption;
 extern struct st_maria_plugin	i_s_innodb_tablespaces_scrubbing;
 extern struct st_maria_plugin	i_s_innodb_sys_semaphore_waits;
+#ifdef BTR_CUR_HASH_ADAPT
+extern struct st_maria_plugin	i_s_innodb_ahi_partitions;
+#endif /* BTR_CUR_HASH_ADAPT */
 
 /** The latest successfully looked up innodb_fts_aux_table */
 extern table_id_t innodb_ft_aux_table_id;
@@ -174,6 +174,19 @@ static inline bool btr_search_own_any();
 /** Unlock all search latches from shared mode. */
 static inline void btr_search_s_unlock_all();
 
+/** Acquire a shared latch on an adaptive hash index partition.
+@param[in]	latch	btr_search_latches[] element
+@return the latch that was acquired, to be passed to rw_lock_s_unlock() */
+static inline rw_lock_t* btr_search_s_lock(rw_lock_t* latch);
+
+/** Acquire an exclusive latch on an adaptive hash index partition.
+@param[in]	latch	btr_search_latches[] element */
+static inline void btr_search_x_lock(rw_lock_t* latch);
+
+/** Release an exclusive latch on an adaptive hash index partition.
+@param[in]	latch	btr_search_latches[] element */
+static inline void btr_search_x_unlock(rw_lock_t* latch);
+
 /** Get the latch based on index attributes.
 A latch is selected from an array of latches using pair of index-id, space-id.
 @param[in]	index	index handler
@@ -255,6 +268,17 @@ struct btr_search_t{
 				the same prefix should be indexed in the
 				hash index */
 	/*---------------------- @} */
+	/* @{ Approximate statistics for btr_search_min_hit_pct,
+	not protected by any latch. */
+	ulint	n_hits;		/*!< successful hash searches
+				in the current window */
+	ulint	n_misses;	/*!< searches that were not satisfied
+				by the hash index in the current window */
+	ulint	n_skip;		/*!< number of windows during which no page
+				hash indexes will be built for the index */
+	ulint	n_skip_next;	/*!< value of n_skip to assign when the
+				hit ratio is found to be too low again */
+	/* @} */
 #ifdef UNIV_SEARCH_PERF_STAT
 	ulint	n_hash_succ;	/*!< number of successful hash searches thus
 				far */
@@ -279,9 +303,34 @@ struct btr_search_sys_t{
 					to rec_t pointers on index pages */
 };
 
-/** Latches protecting access to adaptive hash index. */
+/** Number of shared latch slots in each adaptive hash index partition */
+#define BTR_SEARCH_N_SLOTS	8
+
+/** A shared latch slot of an adaptive hash index partition.
+Readers acquire an s-latch on one of the BTR_SEARCH_N_SLOTS slots,
+while writers acquire an x-latch on all of them. */
+struct btr_search_slot_t{
+	rw_lock_t	latch;		/*!< the latch */
+	ulint		n_hits;		/*!< number of successful hash
+					searches; approximate, updated
+					without atomic operations */
+	ulint		n_misses;	/*!< number of failed hash
+					searches; approximate */
+	byte		pad[CACHE_LINE_SIZE
+			    - (sizeof(rw_lock_t) + 2 * sizeof(ulint))
+			    % CACHE_LINE_SIZE];
+					/*!< padding to prevent false sharing */
+};
+
+/** Latches protecting access to adaptive hash index.
+Each element points to the first of BTR_SEARCH_N_SLOTS btr_search_slot_t. */
 extern rw_lock_t**		btr_search_latches;
 
+/** Minimum adaptive hash index hit ratio of an index, in per cent,
+below which no further page hash indexes are built for the index;
+0 disables the check */
+extern ulong			btr_search_min_hit_pct;
+
 /** The adaptive hash index */
 extern btr_search_sys_t*	btr_search_sys;
 
@@ -297,6 +346,14 @@ before starting the hash analysis again: this is to save CPU time when there
 is no hope in building a hash index. */
 #define BTR_SEARCH_HASH_ANALYSIS	17
 
+/** Number of searches in an index after which the hit ratio of the
+adaptive hash index is evaluated against btr_search_min_hit_pct */
+#define BTR_SEARCH_HIT_WINDOW		10000
+
+/** Maximum number of BTR_SEARCH_HIT_WINDOW during which no page hash
+indexes will be built after the hit ratio was found to be too low */
+#define BTR_SEARCH_MAX_SKIP		64
+
 /** Limit of consecutive searches for trying a search shortcut on the search
 pattern */
 #define BTR_SEARCH_ON_PATTERN_LIMIT	3
@@ -159,6 +159,8 @@ struct buf_pool_info_t{
 	ulint	n_pages_read;		/*!< buf_pool->n_pages_read */
 	ulint	n_pages_created;	/*!< buf_pool->n_pages_created */
 	ulint	n_pages_written;	/*!< buf_pool->n_pages_written */
+	ulint	n_pages_flushed_LRU;	/*!< buf_pool->n_pages_flushed_LRU */
+	ulint	n_pages_flushed_list;	/*!< buf_pool->n_pages_flushed_list */
 	ulint	n_page_gets;		/*!< buf_pool->n_page_gets */
 	ulint	n_ra_pages_read_rnd;	/*!< buf_pool->n_ra_pages_read_rnd,
 					number of pages readahead */
@@ -178,6 +180,10 @@ struct buf_pool_info_t{
 	double	pages_read_rate;	/*!< num of pages read per second */
 	double	pages_created_rate;	/*!< num of pages create per second */
 	double	pages_written_rate;	/*!< num of  pages written per second */
+	double	pages_flushed_LRU_rate;	/*!< num of pages written by LRU
+					batches per second */
+	double	pages_flushed_list_rate;/*!< num of pages written by
+					flush_list batches per second */
 	ulint	page_read_delta;	/*!< num of pages read since last
 					printout */
 	ulint	young_making_delta;	/*!< num of pages made young since
@@ -1981,6 +1987,10 @@ struct buf_pool_stat_t{
 				pool mutex */
 	ulint	n_pages_read;	/*!< number read operations */
 	ulint	n_pages_written;/*!< number write operations */
+	ulint	n_pages_flushed_LRU;/*!< number of pages written
+				by BUF_FLUSH_LRU batches */
+	ulint	n_pages_flushed_list;/*!< number of pages written
+				by BUF_FLUSH_LIST batches */
 	ulint	n_pages_created;/*!< number of pages created
 				in the pool with no read */
 	ulint	n_ra_pages_read_rnd;/*!< number of pages read in
@@ -2177,6 +2187,10 @@ struct buf_pool_t{
 	single page flushing victim.  Protected by buf_pool::mutex. */
 	LRUItr		single_scan_itr;
 
+	/** "hazard pointer" used during scan of LRU while doing
+	a buffer pool dump.  Protected by buf_pool::mutex */
+	LRUHp		dump_hp;
+
 	UT_LIST_BASE_NODE_T(buf_page_t) LRU;
 					/*!< base node of the LRU list */
 
@@ -99,14 +99,17 @@ written to the dblwr buffer on disk. */
 void
 buf_dblwr_sync_datafiles();
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+/** Flush possible buffered writes of a batch from the doublewrite memory
+buffer to disk, and also wake up the aio thread if simulated aio is used.
+It is very important to call this function after a batch of writes has
+been posted, and also when we may have to wait for a page latch!
+Otherwise a deadlock of threads can occur.
+@param[in]	buf_pool	buffer pool instance of the batch
+@param[in]	flush_type	BUF_FLUSH_LRU or BUF_FLUSH_LIST */
 void
-buf_dblwr_flush_buffered_writes();
+buf_dblwr_flush_buffered_writes(
+	const buf_pool_t*	buf_pool,
+	buf_flush_t		flush_type);
 
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
@@ -122,6 +125,30 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
+/** Batch area of a parallel doublewrite file (innodb_parallel_doublewrite).
+Each buffer pool instance has a file of its own, holding one area for
+BUF_FLUSH_LIST and one for BUF_FLUSH_LRU batches. */
+struct buf_dblwr_shard_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the fields below */
+	pfs_os_file_t	file;	/*!< the doublewrite file */
+	const char*	path;	/*!< path name of the file */
+	os_offset_t	offset;	/*!< offset of the area in the file */
+	ulint		first_free;/*!< first free position in write_buf
+				measured in units of srv_page_size */
+	ulint		b_reserved;/*!< number of slots currently reserved
+				for the batch */
+	os_event_t	b_event;/*!< event where threads wait for a
+				batch flush to end; protected by mutex */
+	bool		batch_running;/*!< whether the batch is being
+				written from the doublewrite buffer */
+	byte*		write_buf;/*!< write buffer, aligned to
+				srv_page_size */
+	byte*		write_buf_unaligned;/*!< pointer to write_buf,
+				but unaligned */
+	buf_page_t**	buf_block_arr;/*!< the buffer blocks which have
+				been copied to write_buf */
+};
+
 /** Doublewrite control struct */
 struct buf_dblwr_t{
 	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
@@ -156,6 +183,12 @@ struct buf_dblwr_t{
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
+	buf_dblwr_shard_t* shards;/*!< batch areas of the parallel
+				doublewrite files, two per buffer pool
+				instance, or NULL if batches are written
+				to the system tablespace */
+	byte*		recv_buf;/*!< page frames read from the parallel
+				doublewrite files at startup, or NULL */
 };
 
 #endif
@@ -46,6 +46,10 @@ void
 buf_load_start();
 /*============*/
 
+/** Wake up the buffer pool dump/load thread after
+innodb_buffer_pool_dump_interval was changed. */
+void buf_dump_interval_changed();
+
 /*****************************************************************//**
 Aborts a currently running buffer pool load. This function is called by
 MySQL code via buffer_pool_load_abort() and it should return immediately
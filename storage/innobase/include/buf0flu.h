@@ -246,6 +246,13 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 void
 buf_flush_page_cleaner_init(void);
 
+/** Notify the page cleaner that a buffer pool instance is running out of
+free blocks.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	empty		whether no free block could be found */
+void
+buf_flush_LRU_notify(const buf_pool_t* buf_pool, bool empty);
+
 /** Wait for any possible LRU flushes that are in progress to end. */
 void
 buf_flush_wait_LRU_batch_end(void);
@@ -30,6 +30,8 @@ Created 04/01/2015 Jan Lindström
 #include "my_crypt.h"
 #include "fil0fil.h"
 
+#include <atomic>
+
 /**
 * Magic pattern in start of crypt data on page 0
 */
@@ -150,6 +152,23 @@ struct fil_space_crypt_t : st_encryption_scheme
 	is not found from encryption plugin. */
 	uint key_get_latest_version(void);
 
+	/** Get the latest key version for encrypting a page. The
+	encryption plugin is consulted at most once per
+	FIL_CRYPT_KEY_REFRESH_NS, so that a whole flush batch will
+	normally use the result of a single lookup.
+	@param[out]	refreshed	whether the plugin was consulted
+	@retval key_version or
+	@retval ENCRYPTION_KEY_VERSION_INVALID if used key_id
+	is not found from encryption plugin. */
+	uint key_get_cached_version(bool* refreshed);
+
+	/** Look up the tablespace-local key of a key version,
+	without acquiring mutex if the key is cached.
+	@param[in]	key_version	key version
+	@param[out]	key		tablespace-local key
+	@return 0 or error code from encryption_key_get() */
+	uint local_key_get(uint key_version, byte* key);
+
 	/** Returns true if key was found from encryption plugin
 	and false if not. */
 	bool is_key_found() const {
@@ -197,6 +216,26 @@ struct fil_space_crypt_t : st_encryption_scheme
 	at startup. */
 	uint key_found;
 
+	/** my_interval_timer() of the last key_get_latest_version() */
+	std::atomic<ulonglong> key_checked;
+
+	/** Cached tablespace-local key */
+	struct local_key_t {
+		/** Sequence number; odd while the entry is being
+		written (by a thread holding mutex) */
+		std::atomic<uint32_t>	seq;
+		/** key version, or 0 if the entry is not in use */
+		std::atomic<uint>	version;
+		/** the key, derived from iv and the global key */
+		byte			key[MY_AES_BLOCK_SIZE];
+	};
+
+	/** Cache of recently used tablespace-local keys */
+	local_key_t local_keys[4];
+
+	/** Entry of local_keys[] to overwrite next; protected by mutex */
+	uint local_key_next;
+
 	fil_space_rotate_state_t rotate_state;
 };
 
@@ -212,6 +251,8 @@ struct fil_space_crypt_status_t {
 	bool flushing;           /*!< is flush at end of rotation ongoing */
 	ulint rotate_next_page_number; /*!< next page if key rotating */
 	ulint rotate_max_page_number;  /*!< max page if key rotating */
+	ulint rotate_seconds_left;     /*!< estimated time to complete the
+				       key rotation, or ULINT_UNDEFINED */
 };
 
 /** Statistics about encryption key rotation */
@@ -221,6 +262,8 @@ struct fil_crypt_stat_t {
 	ulint pages_modified;
 	ulint pages_flushed;
 	ulint estimated_iops;
+	ulint threads_joined;	/*!< joins of an ongoing rotation by
+				fil_crypt_join_rotating_space() */
 };
 
 /** Status info about scrubbing */
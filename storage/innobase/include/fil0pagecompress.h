@@ -30,6 +30,9 @@ atomic writes information to table space.
 Created 11/12/2013 Jan Lindström jan.lindstrom@skysql.com
 ***********************************************************************/
 
+/** Free the idle page_compressed compression contexts at shutdown. */
+void fil_comp_ctx_pool_free();
+
 /** Compress a page_compressed page before writing to a data file.
 @param[in]	buf		page to be compressed
 @param[out]	out_buf		compressed page
@@ -383,6 +383,9 @@ extern ulong		fts_max_cache_size;
 /** Variable specifying the total memory allocated for FTS cache */
 extern ulong		fts_max_total_cache_size;
 
+/** Number of threads for tokenizing inserted documents at commit */
+extern ulong		fts_commit_threads;
+
 /** Variable specifying the FTS result cache limit for each query */
 extern size_t		fts_result_cache_limit;
 
@@ -56,6 +56,11 @@ class ReadView;
 /** The value of innodb_deadlock_detect */
 extern my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_interval: milliseconds between
+wait-for graph searches by lock_wait_timeout_thread, or 0 if deadlocks
+are checked by each transaction that starts a lock wait */
+extern ulong	innodb_deadlock_detect_interval;
+
 /*********************************************************************//**
 Gets the size of a lock struct.
 @return size in bytes */
@@ -702,6 +707,14 @@ lock_table_has_locks(
 					held on records in this table or on the
 					table itself */
 
+/** Take a snapshot of the wait-for graph of the suspended lock waits,
+search it for cycles, and resolve each cycle by rolling back a victim.
+Invoked by lock_wait_timeout_thread when innodb_deadlock_detect_interval
+is set. lock_sys.mutex is only held while copying the graph and while
+resolving the cycles that were found. */
+void
+lock_deadlock_check_waits();
+
 /*********************************************************************//**
 A thread which wakes up threads whose lock wait may have lasted too long.
 @return a dummy parameter */
@@ -812,6 +825,20 @@ struct lock_op_t{
 
 typedef ib_mutex_t LockMutex;
 
+/** Number of latches that the cells of lock_sys.rec_hash are divided among */
+#define LOCK_REC_N_SHARDS	16
+
+/** Bitmap of all lock_sys.rec_shards[] positions */
+#define LOCK_REC_ALL_SHARDS	((1U << LOCK_REC_N_SHARDS) - 1)
+
+/** A latch protecting the record locks whose lock_sys.rec_hash cell
+number modulo LOCK_REC_N_SHARDS equals its position in
+lock_sys.rec_shards[] */
+struct lock_rec_shard_t {
+	MY_ALIGNED(CACHE_LINE_SIZE)
+	LockMutex	mutex;		/*!< the latch */
+};
+
 /** The lock system struct */
 class lock_sys_t
 {
@@ -828,6 +855,15 @@ class lock_sys_t
 	hash_table_t*	prdt_page_hash;		/*!< hash table of the page
 						lock */
 
+	lock_rec_shard_t rec_shards[LOCK_REC_N_SHARDS];
+						/*!< Latches protecting the
+						cells of rec_hash. Holders of
+						mutex hold all of them;
+						lock_rec_lock() and
+						lock_rec_insert_check_and_lock()
+						acquire only the one of the
+						page for the common cases */
+
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LockMutex	wait_mutex;		/*!< Mutex protecting the
 						next two fields */
@@ -847,6 +883,12 @@ class lock_sys_t
 
 	ulint		n_lock_max_wait_time;	/*!< Max wait time */
 
+	ulint		n_deadlock_max_latency;	/*!< Max time from the start
+						of the last wait in a cycle
+						to its resolution by
+						lock_deadlock_check_waits(),
+						in microseconds */
+
 	os_event_t	timeout_event;		/*!< An event waited for by
 						lock_wait_timeout_thread.
 						Not protected by a mutex,
@@ -887,6 +929,72 @@ class lock_sys_t
 
   /** Closes the lock system at database shutdown. */
   void close();
+
+
+  /**
+    Acquire rec_shards[], after mutex.
+
+    @param[in] shards bitmap of the rec_shards[] positions to acquire
+  */
+  void rec_shards_enter(uint32_t shards= LOCK_REC_ALL_SHARDS)
+  {
+    for (ulint i= 0; i < LOCK_REC_N_SHARDS; i++)
+      if (shards & (1U << i))
+        mutex_enter(&rec_shards[i].mutex);
+  }
+
+
+  /**
+    Release rec_shards[], before mutex.
+
+    @param[in] shards bitmap of the rec_shards[] positions to release
+  */
+  void rec_shards_exit(uint32_t shards= LOCK_REC_ALL_SHARDS)
+  {
+    for (ulint i= LOCK_REC_N_SHARDS; i--; )
+      if (shards & (1U << i))
+        rec_shards[i].mutex.exit();
+  }
+
+
+  /**
+    Try to acquire mutex and rec_shards[] without waiting for mutex.
+
+    @param[in] file file name of the caller
+    @param[in] line line number of the caller
+    @return 0 if the latches were acquired
+  */
+  int x_trylock(const char *file, unsigned line)
+  {
+    if (int err= mutex.trylock(file, line))
+      return err;
+    rec_shards_enter();
+    return 0;
+  }
+
+
+  /**
+    Acquire the rec_shards[] element that protects the record locks of a page.
+    The caller must not hold mutex.
+
+    @param[in] block buffer block of the page
+    @return the acquired latch, to be released with mutex_exit()
+  */
+  LockMutex *rec_shard_enter(const buf_block_t *block);
+
+
+#ifdef UNIV_DEBUG
+  /**
+    Check if the record locks in a rec_hash cell are latched.
+
+    @param[in] cell rec_hash cell number
+    @return whether the rec_shards[] element of the cell is owned
+  */
+  bool rec_shard_own(ulint cell) const
+  {
+    return rec_shards[cell % LOCK_REC_N_SHARDS].mutex.is_owned();
+  }
+#endif /* UNIV_DEBUG */
 };
 
 /*********************************************************************//**
@@ -1002,20 +1110,23 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
+/** Test if lock_sys.mutex can be acquired without waiting.
+On success, lock_sys.rec_shards[] will be acquired as well. */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+	(lock_sys.x_trylock(__FILE__, __LINE__))
 
 /** Test if lock_sys.mutex is owned. */
 #define lock_mutex_own() (lock_sys.mutex.is_owned())
 
-/** Acquire the lock_sys.mutex. */
+/** Acquire the lock_sys.mutex and all lock_sys.rec_shards[]. */
 #define lock_mutex_enter() do {			\
 	mutex_enter(&lock_sys.mutex);		\
+	lock_sys.rec_shards_enter();		\
 } while (0)
 
-/** Release the lock_sys.mutex. */
+/** Release the lock_sys.mutex and all lock_sys.rec_shards[]. */
 #define lock_mutex_exit() do {			\
+	lock_sys.rec_shards_exit();		\
 	lock_sys.mutex.exit();			\
 } while (0)
 
@@ -106,6 +106,22 @@ log_write_low(
 /*==========*/
 	const byte*	str,		/*!< in: string */
 	ulint		str_len);	/*!< in: string length */
+/** Reserve space in the log buffer for a log record group, to be filled
+in by log_write_reserved() after log_sys.mutex has been released.
+The block headers of the reserved area are initialized here.
+The caller must invoke log_reserve_and_open() before and log_close()
+after this, and finally log_sys.set_ready() once the records have been
+copied.
+@param[in]	len	length of the log record group, excluding framing
+@return start of the reserved area in log_sys.buf */
+byte* log_reserve_low(ulint len);
+/** Copy log records to an area that was reserved by log_reserve_low().
+This does not require log_sys.mutex.
+@param[in,out]	ptr	current position in the reserved area
+@param[in]	str	log records
+@param[in]	len	length of str
+@return the position after the copied records */
+byte* log_write_reserved(byte* ptr, const byte* str, ulint len);
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -163,6 +179,8 @@ log_set_capacity(ulonglong file_size)
 /** Ensure that the log has been written to the log file up to a given
 log entry (such as that of a transaction commit). Start a new write, or
 wait and check if an already running write is covering the request.
+If innodb_log_writer_threads=ON, wait for log_writer_thread and
+log_flusher_thread to do the write instead.
 @param[in]	lsn		log sequence number that should be
 included in the redo log file write
 @param[in]	flush_to_disk	whether the written log should also
@@ -170,6 +188,9 @@ be flushed to the file system
 @param[in]	rotate_key	whether to rotate the encryption key */
 void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key = false);
 
+/** Start log_writer_thread and log_flusher_thread. */
+void log_writer_threads_start();
+
 /** write to the log file up to the last log entry.
 @param[in]	sync	whether we want the written log
 also to be flushed to disk. */
@@ -489,6 +510,9 @@ MariaDB 10.2.18 and later will use the 10.3 format, but LOG_HEADER_SUBFORMAT
 					header */
 #define LOG_FILE_HDR_SIZE	(4 * OS_FILE_LOG_BLOCK_SIZE)
 
+/** Number of events in log_sys.write_notify and log_sys.flush_notify */
+#define LOG_NOTIFY_SLOTS	1024
+
 typedef ib_mutex_t	LogSysMutex;
 typedef ib_mutex_t	FlushOrderMutex;
 
@@ -501,6 +525,13 @@ struct log_t{
 
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LogSysMutex	mutex;		/*!< mutex protecting the log */
+	/** the log buffer has been completely filled up to this lsn,
+	and all dirty pages of the mini-transactions that ended before it
+	have been added to the flush lists. Space in buf is reserved
+	while holding mutex, but mtr_t::commit() copies the records
+	without holding it, and advances this field in the LSN order. */
+	MY_ALIGNED(CACHE_LINE_SIZE)
+	std::atomic<lsn_t>	buf_ready_lsn;
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LogSysMutex	write_mutex;	/*!< mutex protecting writing to log */
 	MY_ALIGNED(CACHE_LINE_SIZE)
@@ -583,6 +614,12 @@ struct log_t{
     @return	whether no invalid blocks (e.g checksum mismatch) were found */
     bool read_log_seg(lsn_t* start_lsn, lsn_t end_lsn);
 
+    /** Advise the operating system to start reading a log segment
+    that read_log_seg() will be invoked on later.
+    @param[in]	lsn	start of the segment
+    @param[in]	len	length of the segment, in bytes */
+    void read_ahead(lsn_t lsn, ulint len) const;
+
     /** Initialize the redo log buffer.
     @param[in]	n_files		number of files */
     void create(ulint n_files);
@@ -620,6 +657,20 @@ struct log_t{
 					when a flush is running;
 					os_event_set() and os_event_reset()
 					are protected by log_sys.mutex */
+	os_event_t	writer_event;	/*!< wakes up log_writer_thread */
+	os_event_t	flusher_event;	/*!< wakes up log_flusher_thread */
+	os_event_t*	write_notify;	/*!< LOG_NOTIFY_SLOTS events for
+					waiting until write_lsn has been
+					advanced by log_writer_thread,
+					indexed by log_notify_slot() */
+	os_event_t*	flush_notify;	/*!< LOG_NOTIFY_SLOTS events for
+					waiting until flushed_to_disk_lsn
+					has been advanced by
+					log_flusher_thread */
+	std::atomic<lsn_t>
+			flush_requested_lsn;/*!< the largest lsn that
+					a thread is waiting to be flushed
+					by log_flusher_thread */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
@@ -700,6 +751,23 @@ struct log_t{
   /** Complete an asynchronous checkpoint write. */
   void complete_checkpoint();
 
+  /** @return the lsn up to which the log buffer has been filled */
+  lsn_t get_ready() const
+  { return buf_ready_lsn.load(std::memory_order_acquire); }
+
+  /** Note that the log buffer has been filled up to a lsn.
+  @param[in]	lsn	end lsn of the log written by the caller */
+  void set_ready(lsn_t lsn)
+  {
+    ut_ad(lsn >= buf_ready_lsn.load(std::memory_order_relaxed));
+    buf_ready_lsn.store(lsn, std::memory_order_release);
+  }
+
+  /** Wait until the log buffer has been filled up to a lsn by
+  concurrent mtr_t::commit().
+  @param[in]	lsn	log sequence number */
+  void wait_ready(lsn_t lsn) const;
+
   /** @return the log block header + trailer size */
   unsigned framing_size() const
   {
@@ -816,6 +884,11 @@ extern os_event_t	log_scrub_event;
 /** Whether log_scrub_thread is active */
 extern bool		log_scrub_thread_active;
 
+/** Whether log_writer_thread is active */
+extern bool		log_writer_thread_active;
+/** Whether log_flusher_thread is active */
+extern bool		log_flusher_thread_active;
+
 #include "log0log.ic"
 
 #endif
@@ -86,6 +86,10 @@ recv_sys_var_init(void);
 void
 recv_apply_hashed_log_recs(bool last_batch);
 
+/** Print the progress of applying the redo log to SHOW ENGINE INNODB STATUS.
+@param[in,out]	file	output stream */
+void recv_print(FILE* file);
+
 /** Whether to store redo log records to the hash table */
 enum store_t {
 	/** Do not store redo log records. */
@@ -238,6 +242,21 @@ struct recv_sys_t{
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
 
+	/** number of recv_apply_hashed_log_recs() batches started */
+	ulint		n_apply_batches;
+	/** number of threads applying the current or last batch */
+	ulint		n_apply_threads;
+	/** number of pages in the current or last batch */
+	ulint		n_batch_pages;
+	/** number of pages to which the redo log has been applied */
+	ulint		n_pages_applied;
+	/** number of pages that recv_read_in_batch() submitted for reading */
+	ulint		n_pages_read_ahead;
+	/** time when the first batch was started */
+	ib_time_t	apply_start_time;
+	/** time when the last batch was completed */
+	ib_time_t	apply_end_time;
+
 	/** Undo tablespaces for which truncate has been logged
 	(indexed by id - srv_undo_space_id_start) */
 	struct trunc {
@@ -77,7 +77,8 @@ class ReadView
 
 
 public:
-  ReadView(): m_state(READ_VIEW_STATE_CLOSED), m_low_limit_id(0) {}
+  ReadView(): m_state(READ_VIEW_STATE_CLOSED), m_low_limit_id(0),
+              m_erased(0) {}
 
 
   /**
@@ -283,6 +284,11 @@ class ReadView
 	was taken */
 	trx_ids_t	m_ids;
 
+	/** trx_sys.get_rw_trx_hash_erased() when this snapshot was
+	taken. Together with m_low_limit_id, allows ReadView::open() to
+	reuse the snapshot while rw_trx_hash has not changed. */
+	trx_id_t	m_erased;
+
 	/** The view does not need to see the undo logs for transactions
 	whose transaction number is strictly smaller (<) than this value:
 	they can be removed in purge if not needed by other views */
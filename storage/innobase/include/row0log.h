@@ -38,7 +38,7 @@ class ut_stage_alter_t;
 
 extern Atomic_counter<ulint> onlineddl_rowlog_rows;
 extern ulint onlineddl_rowlog_pct_used;
-extern ulint onlineddl_pct_progress;
+extern Atomic_counter<ulint> onlineddl_pct_progress;
 
 /******************************************************//**
 Allocate the row log for an index and flag the index
@@ -128,12 +128,18 @@ struct index_def_t {
 /** Structure for reporting duplicate records. */
 struct row_merge_dup_t {
 	dict_index_t*		index;	/*!< index being sorted */
-	struct TABLE*		table;	/*!< MySQL table object */
+	struct TABLE*		table;	/*!< MySQL table object, or NULL
+					to only count the duplicates */
 	const ulint*		col_map;/*!< mapping of column numbers
 					in table to the rebuilt table
 					(index->table), or NULL if not
 					rebuilding table */
 	ulint			n_dup;	/*!< number of duplicates */
+	std::atomic<const dict_index_t*>*
+				reported;/*!< in/out: the index whose
+					duplicate was copied to table, when
+					several indexes are built concurrently;
+					or NULL */
 };
 
 /*************************************************************//**
@@ -411,6 +417,7 @@ row_merge_file_create(
 @param[in,out]	block	3 buffers
 @param[in,out]	tmpfd	temporary file handle
 @param[in]      update_progress true, if we should update progress status
+                and report progress to the client
 @param[in]      pct_progress total progress percent until now
 @param[in]      pct_ocst current progress percent
 @param[in]      crypt_block crypt buf or NULL
@@ -562,9 +562,15 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Initial number of rows to prefetch into fetch_cache */
 #define MYSQL_FETCH_CACHE_SIZE		8
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
+/* Maximum size of fetch_cache in bytes; a long scan doubles the number
+of rows to prefetch on each refill of the cache, up to this size */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(128 << 10)
+/* Maximum number of rows in fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX_ROWS	1024
 
 #define ROW_PREBUILT_ALLOCATED	78540783
 #define ROW_PREBUILT_FREED	26423527
@@ -737,16 +743,27 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte**		fetch_cache;
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
 					batch; we reserve mysql_row_len
 					bytes for each such row; these
 					pointers point 4 bytes past the
-					allocated mem buf start, because
+					start of each row buffer, because
 					there is a 4 byte magic number at the
-					start and at the end */
+					start and at the end; NULL if not
+					allocated */
+	ulint		fetch_cache_size;/*!< number of row buffers
+					allocated in fetch_cache */
+	ulint		fetch_cache_limit;/*!< number of rows to prefetch
+					into fetch_cache, at least
+					MYSQL_FETCH_CACHE_SIZE */
+	ulint		fetch_cache_scan_rows;/*!< number of rows that
+					the SQL layer expects a long scan
+					to return, or 0 if no scan was
+					announced; the prefetch then starts
+					at this size, up to the maximum */
 	bool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
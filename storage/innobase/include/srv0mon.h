@@ -372,6 +372,7 @@ enum monitor_id_t {
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND,
 	MONITOR_ADAPTIVE_HASH_ROW_UPDATED,
+	MONITOR_ADAPTIVE_HASH_BUILD_SKIPPED,
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	/* Tablespace related counters */
@@ -83,6 +83,19 @@ struct srv_stats_t
 	space in the log buffer and have to flush it */
 	ulint_ctr_1_t		log_waits;
 
+	/** Number of log flushes by log_flusher_thread */
+	ulint_ctr_1_t		log_flusher_batches;
+
+	/** Amount of log flushed by log_flusher_thread in bytes */
+	lsn_ctr_1_t		log_flusher_batch_bytes;
+
+	/** Number of waits for log_writer_thread or log_flusher_thread */
+	ulint_ctr_1_t		log_flusher_waits;
+
+	/** Time spent waiting for log_writer_thread or log_flusher_thread,
+	in microseconds */
+	int64_ctr_1_t		log_flusher_wait_time;
+
 	/** Count the number of times the doublewrite buffer was flushed */
 	ulint_ctr_1_t		dblwr_writes;
 
@@ -120,6 +133,16 @@ struct srv_stats_t
         ulint_ctr_64_t          pages_page_decompressed;
 	/* Number of page compression errors */
 	ulint_ctr_64_t          pages_page_compression_error;
+	/** Number of pages compressed, by page_compressed algorithm */
+	ulint_ctr_1_t		page_compression_pages[PAGE_ALGORITHM_LAST + 1];
+	/** Size of the compressed data, by page_compressed algorithm */
+	ulint_ctr_1_t		page_compression_bytes[PAGE_ALGORITHM_LAST + 1];
+	/** Nanoseconds spent compressing pages, by algorithm */
+	int64_ctr_1_t		page_compression_time[PAGE_ALGORITHM_LAST + 1];
+	/** Number of pages decompressed, by page_compressed algorithm */
+	ulint_ctr_1_t		page_decompression_pages[PAGE_ALGORITHM_LAST + 1];
+	/** Nanoseconds spent decompressing pages, by algorithm */
+	int64_ctr_1_t		page_decompression_time[PAGE_ALGORITHM_LAST + 1];
 	/* Number of pages encrypted */
 	ulint_ctr_64_t          pages_encrypted;
    	/* Number of pages decrypted */
@@ -142,6 +165,40 @@ struct srv_stats_t
 	/** Number of database lock waits */
 	ulint_ctr_1_t		n_lock_wait_count;
 
+	/** Number of wait-for graph snapshots taken by
+	lock_deadlock_check_waits() */
+	ulint_ctr_1_t		deadlock_detect_snapshots;
+
+	/** Time spent holding lock_sys.mutex for wait-for graph
+	snapshots, in microseconds */
+	int64_ctr_1_t		deadlock_detect_snapshot_time;
+
+	/** Number of deadlocks resolved by lock_deadlock_check_waits() */
+	ulint_ctr_1_t		deadlock_detect_cycles;
+
+	/** Total time from the start of the last wait in a cycle to
+	its resolution by lock_deadlock_check_waits(), in microseconds */
+	int64_ctr_1_t		deadlock_detect_latency;
+
+	/** Number of undo log records fetched for purge */
+	ulint_ctr_1_t		purge_records;
+
+	/** Number of committed undo logs processed by purge */
+	ulint_ctr_1_t		purge_undo_logs;
+
+	/** Number of FULLTEXT cache syncs */
+	ulint_ctr_1_t		fts_syncs;
+
+	/** Time spent in FULLTEXT cache syncs, in nanoseconds */
+	int64_ctr_1_t		fts_sync_time;
+
+	/** Number of FULLTEXT cache syncs that blocked changes to the
+	cache until the end of the sync */
+	ulint_ctr_1_t		fts_sync_stalls;
+
+	/** Memory used by the FULLTEXT caches of all tables, in bytes */
+	int64_ctr_1_t		fts_cache_size;
+
 	/** Number of threads currently waiting on database locks */
 	MY_ALIGNED(CACHE_LINE_SIZE) Atomic_counter<ulint>
 				n_lock_wait_current_count;
@@ -149,6 +206,14 @@ struct srv_stats_t
 	/** Number of rows read. */
 	ulint_ctr_64_t		n_rows_read;
 
+	/** Number of read views opened by taking a new snapshot
+	of rw_trx_hash */
+	ulint_ctr_64_t		read_view_snapshots;
+
+	/** Number of read views opened by reusing the previous
+	snapshot, because rw_trx_hash had not changed */
+	ulint_ctr_64_t		read_views_reused;
+
 	/** Number of rows updated */
 	ulint_ctr_64_t		n_rows_updated;
 
@@ -260,6 +325,10 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads for reading the clustered index in index creation */
+extern ulong	srv_alter_scan_threads;
+/** Number of secondary indexes to build concurrently in index creation */
+extern ulong	srv_alter_build_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -341,6 +410,8 @@ extern ulong	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
 extern ulong	srv_log_write_ahead_size;
+extern my_bool	srv_log_writer_threads;
+extern ulong	srv_n_log_apply_threads;
 extern my_bool	srv_adaptive_flushing;
 extern my_bool	srv_flush_sync;
 
@@ -381,6 +452,10 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** Number of threads for loading the buffer pool */
+extern ulong	srv_buf_pool_load_threads;
+/** Seconds between periodic buffer pool dumps, or 0 */
+extern ulong	srv_buf_pool_dump_interval;
 #ifdef UNIV_DEBUG
 /** Abort load after this amount of pages */
 extern ulong srv_buf_pool_load_pages_abort;
@@ -429,6 +504,9 @@ extern ulong	srv_innodb_stats_method;
 extern ulint	srv_max_n_open_files;
 
 extern ulong	srv_n_page_cleaners;
+/** innodb_lru_flush_threads: whether each buffer pool instance
+has a dedicated LRU flushing thread */
+extern my_bool	srv_LRU_flush_threads;
 
 extern double	srv_max_dirty_pages_pct;
 extern double	srv_max_dirty_pages_pct_lwm;
@@ -462,6 +540,12 @@ extern my_bool			srv_stats_sample_traditional;
 
 extern my_bool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
+/** innodb_parallel_doublewrite: whether batch flushes use a doublewrite
+file per buffer pool instance instead of the system tablespace */
+extern my_bool	srv_parallel_doublewrite;
+/** innodb_parallel_doublewrite_batch_size: number of pages in each
+LRU and flush_list batch area of the parallel doublewrite files */
+extern ulong	srv_parallel_doublewrite_batch_size;
 extern ulong	srv_checksum_algorithm;
 
 extern double	srv_max_buf_pool_modified_pct;
@@ -549,6 +633,7 @@ extern ulong srv_n_purge_threads;
 
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
+extern ulong srv_purge_history_per_thread;
 
 /* the number of sync wait arrays */
 extern ulong srv_sync_array_size;
@@ -919,6 +1004,9 @@ struct export_var_t{
 	char  innodb_buffer_pool_load_status[OS_FILE_MAX_PATH + 128];/*!< Buf pool load status */
 	char  innodb_buffer_pool_resize_status[512];/*!< Buf pool resize status */
 	my_bool innodb_buffer_pool_load_incomplete;/*!< Buf pool load incomplete */
+	ulint innodb_buffer_pool_load_pages_total;/*!< Pages in the buf pool load */
+	ulint innodb_buffer_pool_load_pages_loaded;/*!< Processed pages of the
+						buf pool load */
 	ulint innodb_buffer_pool_pages_total;	/*!< Buffer pool size */
 	ulint innodb_buffer_pool_pages_data;	/*!< Data pages */
 	ulint innodb_buffer_pool_bytes_data;	/*!< File bytes used */
@@ -939,10 +1027,30 @@ struct export_var_t{
 	ulint innodb_buffer_pool_read_ahead_evicted;/*!< srv_read_ahead evicted*/
 	ulint innodb_dblwr_pages_written;	/*!< srv_dblwr_pages_written */
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
+	ulint innodb_deadlock_detect_cycles;	/*!< srv_stats.
+						deadlock_detect_cycles */
+	ulint innodb_deadlock_detect_latency_avg;/*!< deadlock_detect_latency
+						/ deadlock_detect_cycles */
+	ulint innodb_deadlock_detect_latency_max;/*!< lock_sys.
+						n_deadlock_max_latency */
+	ulint innodb_deadlock_detect_snapshots;	/*!< srv_stats.
+						deadlock_detect_snapshots */
+	int64_t innodb_deadlock_detect_snapshot_time;
+						/*!< srv_stats.
+						deadlock_detect_snapshot_time */
+	int64_t innodb_ft_cache_size;		/*!< srv_stats.fts_cache_size */
+	ulint innodb_ft_sync_stalls;		/*!< srv_stats.fts_sync_stalls */
+	int64_t innodb_ft_sync_time;		/*!< srv_stats.fts_sync_time
+						/ 1000 */
+	ulint innodb_ft_syncs;			/*!< srv_stats.fts_syncs */
 	ibool innodb_have_atomic_builtins;	/*!< HAVE_ATOMIC_BUILTINS */
 	ulint innodb_log_waits;			/*!< srv_log_waits */
 	ulint innodb_log_write_requests;	/*!< srv_log_write_requests */
 	ulint innodb_log_writes;		/*!< srv_log_writes */
+	ulint innodb_log_flusher_batches;	/*!< srv_log_flusher_batches */
+	lsn_t innodb_log_flusher_batch_bytes;	/*!< srv_log_flusher_batch_bytes */
+	ulint innodb_log_flusher_waits;		/*!< srv_log_flusher_waits */
+	int64_t innodb_log_flusher_wait_time;	/*!< srv_log_flusher_wait_time */
 	lsn_t innodb_os_log_written;		/*!< srv_os_log_written */
 	ulint innodb_os_log_fsyncs;		/*!< fil_n_log_flushes */
 	ulint innodb_os_log_pending_writes;	/*!< srv_os_log_pending_writes */
@@ -951,6 +1059,15 @@ struct export_var_t{
 	ulint innodb_pages_created;		/*!< buf_pool->stat.n_pages_created */
 	ulint innodb_pages_read;		/*!< buf_pool->stat.n_pages_read*/
 	ulint innodb_pages_written;		/*!< buf_pool->stat.n_pages_written */
+	ulint innodb_purge_lag_records;		/*!< estimated number of undo
+						log records in the history */
+	ulint innodb_purge_lag_seconds;		/*!< purge_sys.lag_seconds */
+	ulint innodb_purge_records;		/*!< srv_stats.purge_records */
+	ulint innodb_purge_threads_active;	/*!< purge_sys.n_active_threads */
+	ulint innodb_read_view_snapshots;	/*!< srv_stats.
+						read_view_snapshots */
+	ulint innodb_read_views_reused;		/*!< srv_stats.
+						read_views_reused */
 	ulint innodb_row_lock_waits;		/*!< srv_n_lock_wait_count */
 	ulint innodb_row_lock_current_waits;	/*!< srv_n_lock_wait_current_count */
 	int64_t innodb_row_lock_time;		/*!< srv_n_lock_wait_time
@@ -1006,6 +1123,16 @@ struct export_var_t{
 						compression */
 	int64_t innodb_pages_page_compression_error;/*!< Number of page
 						compression errors */
+	/** srv_stats.page_compression_pages */
+	ulint innodb_page_compression_pages[PAGE_ALGORITHM_LAST + 1];
+	/** srv_stats.page_compression_bytes */
+	ulint innodb_page_compression_bytes[PAGE_ALGORITHM_LAST + 1];
+	/** srv_stats.page_compression_time / 1000 */
+	int64_t innodb_page_compression_time[PAGE_ALGORITHM_LAST + 1];
+	/** srv_stats.page_decompression_pages */
+	ulint innodb_page_decompression_pages[PAGE_ALGORITHM_LAST + 1];
+	/** srv_stats.page_decompression_time / 1000 */
+	int64_t innodb_page_decompression_time[PAGE_ALGORITHM_LAST + 1];
 	int64_t innodb_pages_encrypted;      /*!< Number of pages
 						encrypted */
 	int64_t innodb_pages_decrypted;      /*!< Number of pages
@@ -1028,6 +1155,7 @@ struct export_var_t{
 	ulint innodb_encryption_rotation_pages_modified;
 	ulint innodb_encryption_rotation_pages_flushed;
 	ulint innodb_encryption_rotation_estimated_iops;
+	ulint innodb_encryption_rotation_threads_joined;
 	int64_t innodb_encryption_key_requests;
 	int64_t innodb_key_rotation_list_length;
 
@@ -1053,6 +1181,8 @@ struct srv_slot_t{
 						suspended. Initialized by
 						lock_wait_table_reserve_slot()
 						for lock wait */
+	uintmax_t	suspend_time_us;	/*!< suspend_time in
+						microseconds, for lock wait */
 	ulong		wait_timeout;		/*!< wait time that if exceeded
 						the thread will be timed out.
 						Initialized by
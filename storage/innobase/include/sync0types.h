@@ -148,6 +148,9 @@ V
 lock_sys_mutex				Mutex protecting lock_sys_t
 |
 V
+lock_sys_shard_mutex			Mutex protecting the record locks
+|					of a part of lock_sys.rec_hash
+V
 trx_sys.mutex				Mutex protecting trx_sys_t
 |
 V
@@ -223,6 +226,7 @@ enum latch_level_t {
 	SYNC_TRX,
 	SYNC_RW_TRX_HASH_ELEMENT,
 	SYNC_TRX_SYS,
+	SYNC_LOCK_SHARD,
 	SYNC_LOCK_SYS,
 	SYNC_LOCK_WAIT_SYS,
 
@@ -329,6 +333,7 @@ enum latch_id_t {
 	LATCH_ID_TRX_POOL_MANAGER,
 	LATCH_ID_TRX,
 	LATCH_ID_LOCK_SYS,
+	LATCH_ID_LOCK_SYS_SHARD,
 	LATCH_ID_LOCK_SYS_WAIT,
 	LATCH_ID_TRX_SYS,
 	LATCH_ID_SRV_SYS,
@@ -222,6 +222,31 @@ class purge_sys_t
 		fil_space_t*	last;
 	} truncate;
 
+	/** Memory heap for the undo log records of the current purge
+	batch (only accessed by the srv_purge_coordinator_thread) */
+	mem_heap_t*	heap;
+
+	/** A sample of the transaction commit number */
+	struct lag_sample_t
+	{
+		/** trx_sys.get_max_trx_id() at the time of the sample */
+		trx_id_t	trx_no;
+		/** time of the sample */
+		time_t		time;
+	};
+	/** number of entries in lag_samples */
+	static const ulint	N_LAG_SAMPLES = 1024;
+	/** Ring buffer of once-per-second samples of the transaction
+	commit number, for estimating the age of the oldest unpurged
+	transaction (only accessed by the srv_purge_coordinator_thread) */
+	lag_sample_t	lag_samples[N_LAG_SAMPLES];
+	/** number of samples taken into lag_samples */
+	ulint		n_lag_samples;
+	/** estimated age of the oldest unpurged transaction, in seconds */
+	ulint		lag_seconds;
+	/** number of threads of the current or latest purge batch */
+	ulint		n_active_threads;
+
   /**
     Constructor.
 
@@ -259,6 +284,10 @@ class purge_sys_t
     m_enabled.store(false, std::memory_order_relaxed);
   }
 
+  /** Sample the transaction commit number and update lag_seconds.
+  Invoked by the srv_purge_coordinator_thread. */
+  void update_lag();
+
   /** @return whether the purge coordinator thread is active */
   bool running();
   /** Stop purge during FLUSH TABLES FOR EXPORT */
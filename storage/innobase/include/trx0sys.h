@@ -802,6 +802,19 @@ class trx_sys_t
   MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_rw_trx_hash_version;
 
 
+  /**
+    Number of transactions removed from rw_trx_hash.
+
+    Together with m_max_trx_id it identifies the contents of rw_trx_hash:
+    if neither has changed, no transaction was registered, serialised or
+    deregistered, and an earlier MVCC snapshot is still exact.
+
+    @sa deregister_rw()
+    @sa ReadView::open()
+  */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_rw_trx_hash_erased;
+
+
   bool m_initialised;
 
 public:
@@ -980,6 +993,19 @@ class trx_sys_t
   {
     m_max_trx_id= value;
     m_rw_trx_hash_version.store(value, std::memory_order_relaxed);
+    m_rw_trx_hash_erased.store(0, std::memory_order_relaxed);
+  }
+
+
+  /**
+    Getter for m_rw_trx_hash_erased, issues ACQUIRE memory barrier.
+
+    Has to be loaded before snapshot_ids(), so that a snapshot is never
+    tagged with a value newer than the rw_trx_hash contents it saw.
+  */
+  trx_id_t get_rw_trx_hash_erased() const
+  {
+    return m_rw_trx_hash_erased.load(std::memory_order_acquire);
   }
 
 
@@ -1029,11 +1055,17 @@ class trx_sys_t
 
     Transaction is removed from rw_trx_hash, which releases all implicit locks.
     MVCC snapshot won't see this transaction anymore.
+
+    m_rw_trx_hash_erased is incremented after the removal, with RELEASE
+    memory barrier, so that read views taken before it cannot be reused.
+    It is read with ACQUIRE memory barrier by get_rw_trx_hash_erased();
+    see ReadView::open() for the ordering of a reused view.
   */
 
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    m_rw_trx_hash_erased.fetch_add(1, std::memory_order_release);
   }
 
 
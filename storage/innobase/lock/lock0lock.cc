@@ -43,7 +43,9 @@ Created 5/7/1996 Heikki Tuuri
 #include "row0vers.h"
 #include "pars0pars.h"
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 #ifdef WITH_WSREP
 #include <mysql/service_wsrep.h>
@@ -55,6 +57,9 @@ ulong innodb_lock_schedule_algorithm;
 /** The value of innodb_deadlock_detect */
 my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_interval */
+ulong	innodb_deadlock_detect_interval;
+
 /*********************************************************************//**
 Checks if a waiting record lock request still has to wait in a queue.
 @return lock that is causing the wait */
@@ -105,6 +110,12 @@ class DeadlockChecker {
 		const lock_t*	lock,
 		trx_t*		trx);
 
+	/** Search a snapshot of the wait-for graph of all suspended
+	lock waits for cycles, and roll back a victim of each cycle.
+	This is used instead of check_and_resolve() when
+	innodb_deadlock_detect_interval is set. */
+	static void check_waits();
+
 private:
 	/** Do a shallow copy. Default destructor OK.
 	@param trx the start transaction (start node)
@@ -464,6 +475,10 @@ void lock_sys_t::create(ulint n_cells)
 
 	mutex_create(LATCH_ID_LOCK_SYS, &mutex);
 
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		mutex_create(LATCH_ID_LOCK_SYS_SHARD, &rec_shards[i].mutex);
+	}
+
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
 	timeout_event = os_event_create(0);
@@ -500,7 +515,7 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	lock_mutex_enter();
 
 	hash_table_t* old_hash = rec_hash;
 	rec_hash = hash_create(n_cells);
@@ -545,7 +560,37 @@ void lock_sys_t::resize(ulint n_cells)
 		buf_pool_mutex_exit(buf_pool);
 	}
 
-	mutex_exit(&mutex);
+	lock_mutex_exit();
+}
+
+/**
+  Acquire the rec_shards[] element that protects the record locks of a page.
+  The caller must not hold mutex.
+
+  @param[in] block buffer block of the page
+  @return the acquired latch, to be released with mutex_exit()
+*/
+LockMutex* lock_sys_t::rec_shard_enter(const buf_block_t* block)
+{
+	ut_ad(this == &lock_sys);
+	ut_ad(!lock_mutex_own());
+
+	for (;;) {
+		/* block->lock_hash_val and rec_hash can only be changed
+		by resize(), which holds all rec_shards[]. */
+		ulint		i = buf_block_get_lock_hash_val(block)
+			% LOCK_REC_N_SHARDS;
+		LockMutex*	shard = &rec_shards[i].mutex;
+
+		mutex_enter(shard);
+
+		if (UNIV_LIKELY(buf_block_get_lock_hash_val(block)
+				% LOCK_REC_N_SHARDS == i)) {
+			return(shard);
+		}
+
+		mutex_exit(shard);
+	}
 }
 
 
@@ -570,6 +615,10 @@ void lock_sys_t::close()
 	mutex_destroy(&mutex);
 	mutex_destroy(&wait_mutex);
 
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		mutex_destroy(&rec_shards[i].mutex);
+	}
+
 	for (ulint i = srv_max_n_threads; i--; ) {
 		if (os_event_t& event = waiting_threads[i].event) {
 			os_event_destroy(event);
@@ -1343,7 +1392,13 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	/* A granted lock on rec_hash may be created while only holding
+	the lock_sys.rec_shards[] element of the page; see lock_rec_lock().
+	Nobody else can be creating locks for trx meanwhile, because
+	that is only done by holders of lock_sys.mutex. */
+	ut_ad(lock_mutex_own()
+	      || (!(type_mode & (LOCK_WAIT | LOCK_PREDICATE | LOCK_PRDT_PAGE))
+		  && lock_sys.rec_shard_own(lock_rec_hash(space, page_no))));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1505,8 +1560,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1946,13 +2001,56 @@ lock_rec_lock(
         (mode & LOCK_TYPE_MASK) == 0);
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
-
-  lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_X ||
          lock_table_has(trx, index->table, LOCK_IX));
 
+  /*
+    Handle the most common cases while only holding the latch of the
+    lock_sys.rec_hash cell of the page: there are no locks on the page,
+    or the only lock is ours and of the requested mode. Neither can
+    involve waiting or other transactions.
+  */
+  LockMutex *shard= lock_sys.rec_shard_enter(block);
+  lock_t *first= lock_rec_get_first_on_page(lock_sys.rec_hash, block);
+
+  if (!first)
+  {
+    /* Note that we don't own the trx mutex. */
+    if (!impl)
+      lock_rec_create(
+#ifdef WITH_WSREP
+         NULL, NULL,
+#endif
+        mode, block, heap_no, index, trx, false);
+
+    err= DB_SUCCESS_LOCKED_REC;
+    mutex_exit(shard);
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return err;
+  }
+
+  if (!lock_rec_get_next_on_page(first) &&
+      first->trx == trx &&
+      first->type_mode == (ulint(mode) | LOCK_REC) &&
+      lock_rec_get_n_bits(first) > heap_no)
+  {
+    if (!impl && !lock_rec_get_nth_bit(first, heap_no))
+    {
+      trx_mutex_enter(trx);
+      lock_rec_set_nth_bit(first, heap_no);
+      trx_mutex_exit(trx);
+      err= DB_SUCCESS_LOCKED_REC;
+    }
+    mutex_exit(shard);
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return err;
+  }
+
+  mutex_exit(shard);
+  lock_mutex_enter();
+
   if (lock_t *lock= lock_rec_get_first_on_page(lock_sys.rec_hash, block))
   {
     trx_mutex_enter(trx);
@@ -4279,14 +4377,49 @@ lock_check_dict_lock(
 }
 #endif /* UNIV_DEBUG */
 
+/** Determine the lock_sys.rec_shards[] that protect the rec_hash cells
+of the record locks of a transaction.
+@param[in]	trx	transaction
+@return bitmap of lock_sys.rec_shards[] positions */
+static
+uint32_t
+lock_trx_rec_shards(const trx_t* trx)
+{
+	uint32_t	shards = 0;
+
+	/* Only holders of lock_sys.mutex add locks of other
+	transactions, and lock_sys_t::resize() holds it as well. */
+	ut_ad(lock_mutex_own());
+
+	for (const lock_t* lock = UT_LIST_GET_FIRST(trx->lock.trx_locks);
+	     lock != NULL && shards != LOCK_REC_ALL_SHARDS;
+	     lock = UT_LIST_GET_NEXT(trx_locks, lock)) {
+
+		if (lock_get_type_low(lock) == LOCK_REC
+		    && !(lock->type_mode & (LOCK_PREDICATE | LOCK_PRDT_PAGE))) {
+			shards |= 1U << (lock_rec_hash(
+					lock->un_member.rec_lock.space,
+					lock->un_member.rec_lock.page_no)
+					 % LOCK_REC_N_SHARDS);
+		}
+	}
+
+	return(shards);
+}
+
 /*********************************************************************//**
 Releases transaction locks, and releases possible other transactions waiting
-because of these locks. */
+because of these locks. Releasing a record lock only accesses the rec_hash
+cell of its page, so the caller need only hold the lock_sys.rec_shards[]
+returned by lock_trx_rec_shards(). */
 static
 void
 lock_release(
 /*=========*/
-	trx_t*	trx)	/*!< in/out: transaction */
+	trx_t*		trx,	/*!< in/out: transaction */
+	uint32_t&	shards)	/*!< in/out: lock_sys.rec_shards[] that
+				are held; all of them after
+				LOCK_RELEASE_INTERVAL locks */
 {
 	lock_t*		lock;
 	ulint		count = 0;
@@ -4302,6 +4435,11 @@ lock_release(
 		ut_d(lock_check_dict_lock(lock));
 
 		if (lock_get_type_low(lock) == LOCK_REC) {
+			ut_ad((lock->type_mode
+			       & (LOCK_PREDICATE | LOCK_PRDT_PAGE))
+			      || lock_sys.rec_shard_own(lock_rec_hash(
+					lock->un_member.rec_lock.space,
+					lock->un_member.rec_lock.page_no)));
 
 			lock_rec_dequeue_from_page(lock);
 		} else {
@@ -4324,11 +4462,14 @@ lock_release(
 
 		if (count == LOCK_RELEASE_INTERVAL) {
 			/* Release the  mutex for a while, so that we
-			do not monopolize it */
+			do not monopolize it. lock_sys_t::resize() may
+			move the cells to other shards meanwhile. */
 
-			lock_mutex_exit();
+			lock_sys.rec_shards_exit(shards);
+			lock_sys.mutex.exit();
 
 			lock_mutex_enter();
+			shards = LOCK_REC_ALL_SHARDS;
 
 			count = 0;
 		}
@@ -5279,23 +5420,36 @@ lock_rec_insert_check_and_lock(
 	ulint		heap_no = page_rec_get_heap_no(next_rec);
 	ut_ad(!rec_is_metadata(next_rec, *index));
 
-	lock_mutex_enter();
-	/* Because this code is invoked for a running transaction by
-	the thread that is serving the transaction, it is not necessary
-	to hold trx->mutex here. */
-
 	/* When inserting a record into an index, the table must be at
 	least IX-locked. When we are building an index, we would pass
 	BTR_NO_LOCKING_FLAG and skip the locking altogether. */
 	ut_ad(lock_table_has(trx, index->table, LOCK_IX));
 
+	/* In the most common case, there are no locks on the successor
+	record. This can be determined while only holding the latch of
+	the lock_sys.rec_hash cell of the page. */
+	LockMutex*	shard = lock_sys.rec_shard_enter(block);
+
 	lock = lock_rec_get_first(lock_sys.rec_hash, block, heap_no);
 
+	mutex_exit(shard);
+
+	if (lock != NULL) {
+		lock_mutex_enter();
+		/* Because this code is invoked for a running transaction by
+		the thread that is serving the transaction, it is not
+		necessary to hold trx->mutex here. */
+
+		lock = lock_rec_get_first(lock_sys.rec_hash, block, heap_no);
+
+		if (lock == NULL) {
+			lock_mutex_exit();
+		}
+	}
+
 	if (lock == NULL) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
-
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
 			page_update_max_trx_id(block,
@@ -6271,8 +6425,9 @@ lock_trx_release_locks(
 	if (release_lock) {
 
 		/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-		is protected by both the lock_sys.mutex and the trx->mutex. */
-		lock_mutex_enter();
+		is protected by both the lock_sys.mutex and the trx->mutex.
+		The lock_sys.rec_shards[] are acquired by lock_release(). */
+		mutex_enter(&lock_sys.mutex);
 	}
 
 	/* The following assignment makes the transaction committed in memory
@@ -6302,7 +6457,7 @@ lock_trx_release_locks(
 
 		ut_a(release_lock);
 
-		lock_mutex_exit();
+		lock_sys.mutex.exit();
 
 		while (trx->is_referenced()) {
 
@@ -6313,16 +6468,24 @@ lock_trx_release_locks(
 			ut_delay(srv_spin_wait_delay);
 		}
 
-		lock_mutex_enter();
+		mutex_enter(&lock_sys.mutex);
 	}
 
 	ut_ad(!trx->is_referenced());
 
 	if (release_lock) {
+		/* Other transactions can no longer convert implicit
+		locks of trx, so its lock list is final. Take only the
+		lock_sys.rec_shards[] of the pages that trx has locked,
+		instead of all of them. */
+		uint32_t	shards = lock_trx_rec_shards(trx);
 
-		lock_release(trx);
+		lock_sys.rec_shards_enter(shards);
 
-		lock_mutex_exit();
+		lock_release(trx, shards);
+
+		lock_sys.rec_shards_exit(shards);
+		lock_sys.mutex.exit();
 	}
 
 	trx->lock.n_rec_locks = 0;
@@ -7007,6 +7170,19 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 		return(NULL);
 	}
 
+	const bool	report_waiters = trx->mysql_thd
+		&& thd_need_wait_reports(trx->mysql_thd);
+
+	/* Leave the search to lock_wait_timeout_thread, unless the
+	waits must be reported to the replication layer as they occur. */
+	if (innodb_deadlock_detect_interval && !report_waiters
+#ifdef WITH_WSREP
+	    && !wsrep_on_trx(trx)
+#endif /* WITH_WSREP */
+	    ) {
+		return(NULL);
+	}
+
 	/*  Release the mutex to obey the latching order.
 	This is safe, because DeadlockChecker::check_and_resolve()
 	is invoked when a lock wait is enqueued for the currently
@@ -7018,8 +7194,6 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 	trx_mutex_exit(trx);
 
 	const trx_t*	victim_trx;
-	const bool	report_waiters = trx->mysql_thd
-		&& thd_need_wait_reports(trx->mysql_thd);
 
 	/* Try and resolve as many deadlocks as possible. */
 	do {
@@ -7075,6 +7249,337 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 	return(victim_trx);
 }
 
+/** Get the next lock request that a waiting lock request has to wait for.
+@param[in]	wait_lock	waiting lock request
+@param[in]	lock		NULL, or the previous return value
+@return next conflicting lock ahead of wait_lock in its queue, or NULL */
+static
+const lock_t*
+lock_get_next_blocker(const lock_t* wait_lock, const lock_t* lock)
+{
+	ut_ad(lock_mutex_own());
+	ut_ad(lock_get_wait(wait_lock));
+
+	if (lock_get_type_low(wait_lock) == LOCK_TABLE) {
+		for (lock = lock
+		     ? UT_LIST_GET_NEXT(un_member.tab_lock.locks, lock)
+		     : UT_LIST_GET_FIRST(
+			     wait_lock->un_member.tab_lock.table->locks);
+		     lock != NULL && lock != wait_lock;
+		     lock = UT_LIST_GET_NEXT(un_member.tab_lock.locks, lock)) {
+			if (lock_has_to_wait(wait_lock, lock)) {
+				return(lock);
+			}
+		}
+
+		return(NULL);
+	}
+
+	ulint	heap_no = lock_rec_find_set_bit(wait_lock);
+
+	for (lock = lock
+	     ? lock_rec_get_next_on_page_const(lock)
+	     : lock_rec_get_first_on_page_addr(
+		     lock_hash_get(wait_lock->type_mode),
+		     wait_lock->un_member.rec_lock.space,
+		     wait_lock->un_member.rec_lock.page_no);
+	     lock != NULL && lock != wait_lock;
+	     lock = lock_rec_get_next_on_page_const(lock)) {
+		if (lock_rec_get_nth_bit(lock, heap_no)
+		    && lock_has_to_wait(wait_lock, lock)) {
+			return(lock);
+		}
+	}
+
+	return(NULL);
+}
+
+/** A suspended transaction in a wait-for graph snapshot */
+struct lock_wait_node_t {
+	/** the waiting transaction */
+	trx_t*		trx;
+	/** trx->lock.wait_lock at the time of the snapshot */
+	const lock_t*	wait_lock;
+	/** start time of the wait, in microseconds */
+	uintmax_t	wait_start;
+	/** position of the first outgoing edge in the edge array */
+	ulint		edges;
+	/** number of outgoing edges */
+	ulint		n_edges;
+	/** number of outgoing edges followed by the search */
+	ulint		n_visited;
+	/** position in the search stack, or ULINT_UNDEFINED if the node
+	is not on the stack */
+	ulint		stack_pos;
+	/** whether the search has visited the node */
+	bool		visited;
+
+	/** Order by transaction */
+	bool operator<(const lock_wait_node_t& other) const
+	{
+		return(trx < other.trx);
+	}
+};
+
+/** Search a snapshot of the wait-for graph of all suspended lock waits
+for cycles, and roll back a victim of each cycle.
+This is used instead of check_and_resolve() when
+innodb_deadlock_detect_interval is set. */
+void
+DeadlockChecker::check_waits()
+{
+	ut_ad(!lock_mutex_own());
+	ut_ad(!lock_wait_mutex_own());
+
+	std::vector<lock_wait_node_t>	nodes;
+	/** the target node of each edge */
+	std::vector<ulint>		edges;
+
+	/* Copy the graph. The slots of the waiting threads are
+	protected by lock_sys.wait_mutex, and the lock queues by
+	lock_sys.mutex. */
+
+	lock_wait_mutex_enter();
+
+	const srv_slot_t*	slot = lock_sys.waiting_threads;
+
+	while (slot < lock_sys.last_slot && !slot->in_use) {
+		++slot;
+	}
+
+	if (slot == lock_sys.last_slot) {
+		/* Avoid acquiring lock_sys.mutex when nothing is waiting. */
+		lock_wait_mutex_exit();
+		return;
+	}
+
+	const uintmax_t	start = ut_time_us(NULL);
+
+	lock_mutex_enter();
+
+	for (; slot < lock_sys.last_slot; ++slot) {
+		if (!slot->in_use) {
+			continue;
+		}
+
+		trx_t*	trx = thr_get_trx(slot->thr);
+
+		if (const lock_t* wait_lock = trx->lock.wait_lock) {
+			lock_wait_node_t	node;
+
+			node.trx = trx;
+			node.wait_lock = wait_lock;
+			node.wait_start = slot->suspend_time_us;
+			node.edges = 0;
+			node.n_edges = 0;
+			node.n_visited = 0;
+			node.stack_pos = ULINT_UNDEFINED;
+			node.visited = false;
+
+			nodes.push_back(node);
+		}
+	}
+
+	lock_wait_mutex_exit();
+
+	std::sort(nodes.begin(), nodes.end());
+
+	for (ulint i = 0; i < nodes.size(); i++) {
+		lock_wait_node_t&	node = nodes[i];
+
+		node.edges = edges.size();
+
+		for (const lock_t* lock = lock_get_next_blocker(
+			     node.wait_lock, NULL);
+		     lock != NULL;
+		     lock = lock_get_next_blocker(node.wait_lock, lock)) {
+
+			/* Only the transactions that are waiting
+			can be part of a cycle. */
+			lock_wait_node_t	key;
+			key.trx = lock->trx;
+
+			std::vector<lock_wait_node_t>::const_iterator	it
+				= std::lower_bound(nodes.begin(), nodes.end(),
+						   key);
+
+			if (it != nodes.end() && it->trx == lock->trx) {
+				edges.push_back(ulint(it - nodes.begin()));
+			}
+		}
+
+		node.n_edges = edges.size() - node.edges;
+	}
+
+	lock_mutex_exit();
+
+	srv_stats.deadlock_detect_snapshots.inc();
+	srv_stats.deadlock_detect_snapshot_time.add(
+		int64_t(ut_time_us(NULL) - start));
+
+	/* Search for cycles by a depth-first search, without holding
+	any latches. Each cycle is recorded as a sequence of nodes, each
+	waiting for the next one, and the last one for the first one,
+	terminated by ULINT_UNDEFINED. */
+
+	std::vector<ulint>	stack;
+	std::vector<ulint>	cycles;
+
+	for (ulint root = 0; root < nodes.size(); root++) {
+		if (nodes[root].visited) {
+			continue;
+		}
+
+		nodes[root].visited = true;
+		nodes[root].stack_pos = 0;
+		stack.push_back(root);
+
+		while (!stack.empty()) {
+			lock_wait_node_t&	node = nodes[stack.back()];
+
+			if (node.n_visited == node.n_edges) {
+				node.stack_pos = ULINT_UNDEFINED;
+				stack.pop_back();
+				continue;
+			}
+
+			ulint			i = edges[node.edges
+							  + node.n_visited++];
+			lock_wait_node_t&	next = nodes[i];
+
+			if (!next.visited) {
+				next.visited = true;
+				next.stack_pos = stack.size();
+				stack.push_back(i);
+			} else if (next.stack_pos != ULINT_UNDEFINED) {
+				cycles.insert(cycles.end(),
+					      stack.begin() + next.stack_pos,
+					      stack.end());
+				cycles.push_back(ULINT_UNDEFINED);
+			}
+		}
+	}
+
+	if (cycles.empty()) {
+		return;
+	}
+
+	/* Roll back a victim of each cycle that still exists. A cycle
+	can have been broken by a lock wait timeout, or by the rollback
+	of the victim of an earlier cycle. */
+
+	lock_mutex_enter();
+
+	const std::vector<ulint>::const_iterator	cycles_end = cycles.end();
+
+	for (std::vector<ulint>::const_iterator first = cycles.begin();
+	     first != cycles_end; ) {
+		std::vector<ulint>::const_iterator	end = std::find(
+			first, cycles_end, ULINT_UNDEFINED);
+		bool		exists = true;
+		trx_t*		victim = NULL;
+		const lock_t*	victim_lock = NULL;
+		uintmax_t	wait_start = 0;
+
+		for (std::vector<ulint>::const_iterator it = first;
+		     exists && it != end; ++it) {
+			const lock_wait_node_t&	node = nodes[*it];
+			const trx_t*		blocker = nodes[
+				it + 1 == end ? *first : it[1]].trx;
+
+			exists = node.trx->lock.wait_lock == node.wait_lock;
+
+			if (exists) {
+				const lock_t*	lock = NULL;
+
+				do {
+					lock = lock_get_next_blocker(
+						node.wait_lock, lock);
+				} while (lock != NULL && lock->trx != blocker);
+
+				exists = lock != NULL;
+			}
+
+			wait_start = std::max(wait_start, node.wait_start);
+
+#ifdef WITH_WSREP
+			if (wsrep_thd_is_BF(node.trx->mysql_thd, TRUE)) {
+				continue;
+			}
+#endif /* WITH_WSREP */
+
+			if (victim == NULL || trx_weight_ge(victim, node.trx)) {
+				victim = node.trx;
+				victim_lock = node.wait_lock;
+			}
+		}
+
+		if (exists && victim != NULL) {
+			ulint	n = 0;
+			ulint	victim_n = 0;
+
+			start_print();
+
+			for (std::vector<ulint>::const_iterator it = first;
+			     it != end; ++it) {
+				const lock_wait_node_t&	node = nodes[*it];
+				char			msg[64];
+
+				snprintf(msg, sizeof msg,
+					 "\n*** (" ULINTPF ") TRANSACTION:\n",
+					 ++n);
+				print(msg);
+				print(node.trx, 3000);
+				snprintf(msg, sizeof msg,
+					 "*** (" ULINTPF ") WAITING FOR THIS"
+					 " LOCK TO BE GRANTED:\n", n);
+				print(msg);
+				print(node.wait_lock);
+
+				if (node.trx == victim) {
+					victim_n = n;
+				}
+			}
+
+			char	msg[64];
+			snprintf(msg, sizeof msg,
+				 "*** WE ROLL BACK TRANSACTION (" ULINTPF ")\n",
+				 victim_n);
+			print(msg);
+
+			trx_mutex_enter(victim);
+			victim->lock.was_chosen_as_deadlock_victim = true;
+			lock_cancel_waiting_and_release(
+				const_cast<lock_t*>(victim_lock));
+			trx_mutex_exit(victim);
+
+			lock_deadlock_found = true;
+			MONITOR_INC(MONITOR_DEADLOCK);
+
+			ulint	latency = ulint(ut_time_us(NULL) - wait_start);
+
+			srv_stats.deadlock_detect_cycles.inc();
+			srv_stats.deadlock_detect_latency.add(int64_t(latency));
+
+			if (latency > lock_sys.n_deadlock_max_latency) {
+				lock_sys.n_deadlock_max_latency = latency;
+			}
+		}
+
+		first = end + 1;
+	}
+
+	lock_mutex_exit();
+}
+
+/** Take a snapshot of the wait-for graph of the suspended lock waits,
+search it for cycles, and resolve each cycle by rolling back a victim. */
+void
+lock_deadlock_check_waits()
+{
+	DeadlockChecker::check_waits();
+}
+
 /*************************************************************//**
 Updates the lock table when a page is split and merged to
 two pages. */
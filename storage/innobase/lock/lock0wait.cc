@@ -156,6 +156,7 @@ lock_wait_table_reserve_slot(
 			os_event_reset(slot->event);
 			slot->suspended = TRUE;
 			slot->suspend_time = ut_time();
+			slot->suspend_time_us = ut_time_us(NULL);
 			slot->wait_timeout = wait_timeout;
 
 			if (slot == lock_sys.last_slot) {
@@ -538,9 +539,16 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 		srv_slot_t*	slot;
 
 		/* When someone is waiting for a lock, we wake up every second
-		and check if a timeout has passed for a lock wait */
+		and check if a timeout has passed for a lock wait. With
+		innodb_deadlock_detect_interval, we also search for
+		deadlocks at that interval. */
 
-		os_event_wait_time_low(event, 1000000, sig_count);
+		const ulong	interval = innobase_deadlock_detect
+			? innodb_deadlock_detect_interval : 0;
+
+		os_event_wait_time_low(event,
+				       interval ? interval * 1000 : 1000000,
+				       sig_count);
 		sig_count = os_event_reset(event);
 
 		if (srv_shutdown_state >= SRV_SHUTDOWN_CLEANUP) {
@@ -570,6 +578,10 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 
 		lock_wait_mutex_exit();
 
+		if (interval) {
+			lock_deadlock_check_waits();
+		}
+
 	} while (srv_shutdown_state < SRV_SHUTDOWN_CLEANUP);
 
 	lock_sys.timeout_thread_active = false;
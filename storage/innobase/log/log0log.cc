@@ -130,6 +130,11 @@ os_event_t	log_scrub_event;
 /** Whether log_scrub_thread is active */
 bool		log_scrub_thread_active;
 
+/** Whether log_writer_thread is active */
+bool		log_writer_thread_active;
+/** Whether log_flusher_thread is active */
+bool		log_flusher_thread_active;
+
 extern "C" UNIV_INTERN
 os_thread_ret_t
 DECLARE_THREAD(log_scrub_thread)(void*);
@@ -147,16 +152,48 @@ log_buf_pool_get_oldest_modification(void)
 
 	ut_ad(log_mutex_own());
 
+	/* A mini-transaction that has reserved log but not yet added
+	its dirty pages to the flush lists cannot have started before
+	log_sys.buf_ready_lsn. This must be read before the flush lists. */
+	const lsn_t ready_lsn = log_sys.get_ready();
+
 	lsn = buf_pool_get_oldest_modification();
 
-	if (!lsn) {
+	if (!lsn || lsn > ready_lsn) {
 
-		lsn = log_sys.lsn;
+		lsn = ready_lsn;
 	}
 
 	return(lsn);
 }
 
+/** Wait until the log buffer has been filled up to a lsn by
+concurrent mtr_t::commit().
+@param[in]	lsn	log sequence number */
+void log_t::wait_ready(lsn_t lsn) const
+{
+	ut_ad(this == &log_sys);
+
+	/* The concurrent mini-transactions are only copying log records
+	and inserting pages to the flush list, so the wait is usually
+	short. Back off exponentially while spinning, then yield, and
+	finally sleep in case the copying thread was descheduled. */
+	ulint	delay = 1;
+
+	for (ulint i = 0; get_ready() < lsn; i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(ut_min(delay, ulint(srv_spin_wait_delay)));
+			if (delay < srv_spin_wait_delay) {
+				delay <<= 1;
+			}
+		} else if (i < 2 * srv_n_spin_wait_rounds) {
+			os_thread_yield();
+		} else {
+			os_thread_sleep(10);
+		}
+	}
+}
+
 /** Extends the log buffer.
 @param[in]	len	requested minimum size in bytes */
 void log_buffer_extend(ulong len)
@@ -175,6 +212,9 @@ void log_buffer_extend(ulong len)
 		return;
 	}
 
+	/* Wait for any concurrent mtr_t::commit() to finish copying. */
+	log_sys.wait_ready(log_sys.lsn);
+
 	ib::warn() << "The redo log transaction size " << len <<
 		" exceeds innodb_log_buffer_size="
 		<< srv_log_buffer_size << " / 2). Trying to extend it.";
@@ -342,6 +382,10 @@ log_write_low(
 
 	ut_ad(log_mutex_own());
 	const ulint trailer_offset = log_sys.trailer_offset();
+
+	/* Wait for any concurrent mtr_t::commit() to finish copying,
+	so that the log buffer is contiguous up to log_sys.lsn. */
+	log_sys.wait_ready(log_sys.lsn);
 part_loop:
 	/* Calculate a part length */
 
@@ -394,9 +438,117 @@ log_write_low(
 		goto part_loop;
 	}
 
+	log_sys.set_ready(log_sys.lsn);
+
 	srv_stats.log_write_requests.inc();
 }
 
+/** Reserve space in the log buffer for a log record group, to be filled
+in by log_write_reserved() after log_sys.mutex has been released.
+The block headers of the reserved area are initialized here.
+
+The reservation itself is not a lock-free fetch-and-add on log_sys.lsn:
+it has to initialize the block headers of the area, and log_sys.lsn and
+log_sys.buf_free are read and reset under log_sys.mutex by
+log_write_up_to(), log_buffer_extend() and the checkpoint and margin
+logic. Only the short arithmetic below is done under the mutex, while
+the copying of the records, which dominates, is done without it.
+The caller must invoke log_reserve_and_open() before and log_close()
+after this, and finally log_sys.set_ready() once the records have been
+copied.
+@param[in]	len	length of the log record group, excluding framing
+@return start of the reserved area in log_sys.buf */
+byte* log_reserve_low(ulint len)
+{
+	ut_ad(log_mutex_own());
+	ut_ad(len > 0);
+
+	const ulint	trailer_offset = log_sys.trailer_offset();
+	byte*		start = log_sys.buf + log_sys.buf_free;
+
+	/* This follows the arithmetic of log_write_low(), except that
+	only the block headers are written. */
+	do {
+		const ulint	offset = log_sys.buf_free
+			% OS_FILE_LOG_BLOCK_SIZE;
+		byte*		log_block = log_sys.buf + log_sys.buf_free
+			- offset;
+		ulint		data_len = offset + len;
+		ulint		part_len;
+
+		if (data_len <= trailer_offset) {
+			/* The rest fits within the current log block */
+			part_len = len;
+		} else {
+			data_len = trailer_offset;
+			part_len = trailer_offset - offset;
+		}
+
+		len -= part_len;
+
+		if (data_len == trailer_offset) {
+			/* This block will become full */
+			log_block_set_data_len(log_block,
+					       OS_FILE_LOG_BLOCK_SIZE);
+			log_block_set_checkpoint_no(
+				log_block, log_sys.next_checkpoint_no);
+			part_len += log_sys.framing_size();
+
+			log_sys.lsn += part_len;
+
+			/* Initialize the next block header */
+			log_block_init(log_block + OS_FILE_LOG_BLOCK_SIZE,
+				       log_sys.lsn);
+		} else {
+			log_block_set_data_len(log_block, data_len);
+			log_sys.lsn += part_len;
+		}
+
+		log_sys.buf_free += ulong(part_len);
+
+		ut_ad(log_sys.buf_free <= srv_log_buffer_size);
+	} while (len);
+
+	srv_stats.log_write_requests.inc();
+
+	return(start);
+}
+
+/** Copy log records to an area that was reserved by log_reserve_low().
+This does not require log_sys.mutex.
+@param[in,out]	ptr	current position in the reserved area
+@param[in]	str	log records
+@param[in]	len	length of str
+@return the position after the copied records */
+byte* log_write_reserved(byte* ptr, const byte* str, ulint len)
+{
+	const ulint	trailer_offset = log_sys.trailer_offset();
+
+	while (len) {
+		const ulint	offset = ut_align_offset(
+			ptr, OS_FILE_LOG_BLOCK_SIZE);
+		ut_ad(offset >= LOG_BLOCK_HDR_SIZE);
+		ut_ad(offset < trailer_offset);
+
+		const ulint	part_len = std::min(len,
+						    trailer_offset - offset);
+
+		memcpy(ptr, str, part_len);
+
+		str += part_len;
+		len -= part_len;
+		ptr += part_len;
+
+		if (offset + part_len == trailer_offset) {
+			/* Skip the trailer and the next block header */
+			ptr += OS_FILE_LOG_BLOCK_SIZE - trailer_offset
+				+ LOG_BLOCK_HDR_SIZE;
+		}
+	}
+
+	return(ptr);
+}
+
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -562,6 +714,11 @@ void log_t::create()
   n_pending_flushes= 0;
   flush_event = os_event_create("log_flush_event");
   os_event_set(flush_event);
+  writer_event= NULL;
+  flusher_event= NULL;
+  write_notify= NULL;
+  flush_notify= NULL;
+  flush_requested_lsn= 0;
   n_log_ios= 0;
   n_log_ios_old= 0;
   log_group_capacity= 0;
@@ -582,6 +739,7 @@ void log_t::create()
 
   buf_free= LOG_BLOCK_HDR_SIZE;
   lsn= LOG_START_LSN + LOG_BLOCK_HDR_SIZE;
+  buf_ready_lsn= lsn;
 
   MONITOR_SET(MONITOR_LSN_CHECKPOINT_AGE, lsn - last_checkpoint_lsn);
 
@@ -860,7 +1018,7 @@ included in the redo log file write
 @param[in]	flush_to_disk	whether the written log should also
 be flushed to the file system
 @param[in]	rotate_key	whether to rotate the encryption key */
-void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
+static void log_write_up_to_low(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 {
 #ifdef UNIV_DEBUG
 	ulint		loop_count	= 0;
@@ -928,6 +1086,10 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 	}
 
 	log_mutex_enter();
+	/* Wait for any concurrent mtr_t::commit() to finish copying,
+	so that the log buffer is contiguous up to log_sys.lsn. */
+	log_sys.wait_ready(log_sys.lsn);
+
 	if (!flush_to_disk
 	    && log_sys.buf_free == log_sys.buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
@@ -1048,6 +1210,259 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 	}
 }
 
+/** @return the slot of log_sys.write_notify or log_sys.flush_notify
+for waiting until a lsn has been written or flushed
+@param[in]	lsn	log sequence number */
+static inline ulint log_notify_slot(lsn_t lsn)
+{
+	return(ulint((lsn - 1) / OS_FILE_LOG_BLOCK_SIZE) % LOG_NOTIFY_SLOTS);
+}
+
+/** Wake up the threads that are waiting for an lsn to be reached.
+@param[in]	events	log_sys.write_notify or log_sys.flush_notify
+@param[in]	old_lsn	the lsn before the write or flush
+@param[in]	new_lsn	the lsn after the write or flush */
+static void log_notify(os_event_t* events, lsn_t old_lsn, lsn_t new_lsn)
+{
+	if (new_lsn <= old_lsn) {
+		return;
+	}
+
+	const lsn_t	first = old_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	const lsn_t	last = (new_lsn - 1) / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (last - first >= LOG_NOTIFY_SLOTS) {
+		for (ulint i = 0; i < LOG_NOTIFY_SLOTS; i++) {
+			os_event_set(events[i]);
+		}
+		return;
+	}
+
+	for (lsn_t b = first; b <= last; b++) {
+		os_event_set(events[ulint(b % LOG_NOTIFY_SLOTS)]);
+	}
+}
+
+/** Wake up the thread that has to act for log_write_wait().
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system */
+static void log_write_wake(lsn_t lsn, bool flush_to_disk)
+{
+	/* If the log has already been written, log_writer_thread
+	has nothing to do, and log_flusher_thread must be woken up
+	directly. */
+	os_event_set(flush_to_disk && log_sys.write_lsn >= lsn
+		     ? log_sys.flusher_event
+		     : log_sys.writer_event);
+}
+
+/** Wait for log_writer_thread and log_flusher_thread to write the log
+up to a given lsn.
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system
+@return whether the wait completed; false if the threads are not running */
+static bool log_write_wait(lsn_t lsn, bool flush_to_disk)
+{
+	const lsn_t&	limit_lsn = flush_to_disk
+		? log_sys.flushed_to_disk_lsn
+		: log_sys.write_lsn;
+
+	if (limit_lsn >= lsn) {
+		return(true);
+	}
+
+	if (flush_to_disk) {
+		lsn_t	requested = log_sys.flush_requested_lsn.load(
+			std::memory_order_relaxed);
+
+		while (requested < lsn
+		       && !log_sys.flush_requested_lsn.compare_exchange_weak(
+			       requested, lsn, std::memory_order_relaxed)) {
+		}
+	}
+
+	os_event_t	event = (flush_to_disk
+				 ? log_sys.flush_notify
+				 : log_sys.write_notify)[log_notify_slot(lsn)];
+	const ulonglong	start = my_interval_timer();
+
+	log_write_wake(lsn, flush_to_disk);
+
+	for (;;) {
+		const int64_t	sig_count = os_event_reset(event);
+
+		if (limit_lsn >= lsn) {
+			break;
+		}
+
+		if (!log_writer_thread_active || !log_flusher_thread_active) {
+			/* The threads were stopped at shutdown */
+			return(false);
+		}
+
+		if (os_event_wait_time_low(event, 100000, sig_count)
+		    == OS_SYNC_TIME_EXCEEDED) {
+			log_write_wake(lsn, flush_to_disk);
+		}
+	}
+
+	srv_stats.log_flusher_waits.inc();
+	srv_stats.log_flusher_wait_time.add(
+		int64_t(my_interval_timer() - start) / 1000);
+
+	return(true);
+}
+
+/** Ensure that the log has been written to the log file up to a given
+log entry (such as that of a transaction commit). Start a new write, or
+wait and check if an already running write is covering the request.
+If innodb_log_writer_threads=ON, wait for log_writer_thread and
+log_flusher_thread to do the write instead.
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system
+@param[in]	rotate_key	whether to rotate the encryption key */
+void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
+{
+	if (!rotate_key && log_writer_thread_active
+	    && log_flusher_thread_active
+	    && !recv_no_ibuf_operations
+	    && log_write_wait(lsn, flush_to_disk)) {
+		return;
+	}
+
+	log_write_up_to_low(lsn, flush_to_disk, rotate_key);
+}
+
+/** Write the log buffer to the log files as soon as there is something
+to write, so that committing transactions do not have to do it.
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(void*)
+{
+	ut_ad(!srv_read_only_mode);
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		const int64_t	sig_count = os_event_reset(
+			log_sys.writer_event);
+		const lsn_t	lsn = log_get_lsn();
+		const lsn_t	old_write_lsn = log_sys.write_lsn;
+		const lsn_t	old_flush_lsn = log_sys.flushed_to_disk_lsn;
+
+		if (lsn <= old_write_lsn) {
+			/* A flush may have been requested for log that
+			was already written. */
+			if (log_sys.flush_requested_lsn.load(
+				    std::memory_order_relaxed)
+			    > old_flush_lsn) {
+				os_event_set(log_sys.flusher_event);
+			}
+
+			os_event_wait_time_low(log_sys.writer_event, 1000000,
+					       sig_count);
+			continue;
+		}
+
+		/* Write everything that has been generated so far,
+		as a single batch. */
+		log_write_up_to_low(lsn, false, false);
+
+		log_notify(log_sys.write_notify, old_write_lsn,
+			   log_sys.write_lsn);
+		/* With innodb_flush_method=O_DSYNC, the write also
+		flushed the log. */
+		log_notify(log_sys.flush_notify, old_flush_lsn,
+			   log_sys.flushed_to_disk_lsn);
+
+		if (log_sys.flush_requested_lsn.load(std::memory_order_relaxed)
+		    > log_sys.flushed_to_disk_lsn) {
+			os_event_set(log_sys.flusher_event);
+		}
+	}
+
+	log_writer_thread_active = false;
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Flush the log that log_writer_thread has written, on behalf of all the
+threads that are waiting for it.
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(void*)
+{
+	ut_ad(!srv_read_only_mode);
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		const int64_t	sig_count = os_event_reset(
+			log_sys.flusher_event);
+		const lsn_t	write_lsn = log_sys.write_lsn;
+		const lsn_t	old_write_lsn = write_lsn;
+		const lsn_t	old_flush_lsn = log_sys.flushed_to_disk_lsn;
+
+		if (log_sys.flush_requested_lsn.load(std::memory_order_relaxed)
+		    <= old_flush_lsn || write_lsn <= old_flush_lsn) {
+			os_event_wait_time_low(log_sys.flusher_event,
+					       1000000, sig_count);
+			continue;
+		}
+
+		/* Flush everything that has been written so far,
+		as a single batch. */
+		log_write_up_to_low(write_lsn, true, false);
+
+		const lsn_t	flush_lsn = log_sys.flushed_to_disk_lsn;
+
+		srv_stats.log_flusher_batches.inc();
+		srv_stats.log_flusher_batch_bytes.add(flush_lsn
+						      - old_flush_lsn);
+
+		log_notify(log_sys.write_notify, old_write_lsn,
+			   log_sys.write_lsn);
+		log_notify(log_sys.flush_notify, old_flush_lsn, flush_lsn);
+	}
+
+	log_flusher_thread_active = false;
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start log_writer_thread and log_flusher_thread. */
+void log_writer_threads_start()
+{
+	ut_ad(!srv_read_only_mode);
+	ut_ad(!log_writer_thread_active);
+	ut_ad(!log_sys.write_notify);
+
+	log_sys.writer_event = os_event_create("log_writer_event");
+	log_sys.flusher_event = os_event_create("log_flusher_event");
+	log_sys.write_notify = static_cast<os_event_t*>(
+		ut_malloc_nokey(2 * LOG_NOTIFY_SLOTS
+				* sizeof *log_sys.write_notify));
+	log_sys.flush_notify = log_sys.write_notify + LOG_NOTIFY_SLOTS;
+
+	for (ulint i = 0; i < 2 * LOG_NOTIFY_SLOTS; i++) {
+		log_sys.write_notify[i] = os_event_create(0);
+	}
+
+	log_sys.flush_requested_lsn = 0;
+	log_writer_thread_active = true;
+	log_flusher_thread_active = true;
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+}
+
 /** write to the log file up to the last log entry.
 @param[in]	sync	whether we want the written log
 also to be flushed to disk. */
@@ -1406,8 +1821,9 @@ bool log_checkpoint(bool sync)
 	It is important that we write out the redo log before any
 	further dirty pages are flushed to the tablespace files.  At
 	this point, because log_mutex_own(), mtr_commit() in other
-	threads will be blocked, and no pages can be added to the
-	flush lists. */
+	threads will be blocked, and only pages whose oldest
+	modification is not older than log_sys.buf_ready_lsn
+	can be added to the flush lists. */
 	lsn_t		flush_lsn	= oldest_lsn;
 	const lsn_t	end_lsn		= log_sys.lsn;
 	const bool	do_write
@@ -1730,13 +2146,22 @@ logs_empty_and_mark_files_at_shutdown(void)
 		os_event_set(log_scrub_event);
 	}
 
+	if (log_writer_thread_active) {
+		os_event_set(log_sys.writer_event);
+	}
+
+	if (log_flusher_thread_active) {
+		os_event_set(log_sys.flusher_event);
+	}
+
 	if (log_sys.is_initialised()) {
 		log_mutex_enter();
 		const ulint	n_write	= log_sys.n_pending_checkpoint_writes;
 		const ulint	n_flush	= log_sys.n_pending_flushes;
 		log_mutex_exit();
 
-		if (log_scrub_thread_active || n_write || n_flush) {
+		if (log_scrub_thread_active || log_writer_thread_active
+		    || log_flusher_thread_active || n_write || n_flush) {
 			if (srv_print_verbose_log && count > 600) {
 				ib::info() << "Pending checkpoint_writes: "
 					<< n_write
@@ -1749,6 +2174,8 @@ logs_empty_and_mark_files_at_shutdown(void)
 	}
 
 	ut_ad(!log_scrub_thread_active);
+	ut_ad(!log_writer_thread_active);
+	ut_ad(!log_flusher_thread_active);
 
 	if (!buf_pool_ptr) {
 		ut_ad(!srv_was_started);
@@ -1943,6 +2370,19 @@ void log_t::close()
   buf = NULL;
 
   os_event_destroy(flush_event);
+
+  if (write_notify)
+  {
+    ut_ad(!log_writer_thread_active);
+    ut_ad(!log_flusher_thread_active);
+    os_event_destroy(writer_event);
+    os_event_destroy(flusher_event);
+    for (ulint i= 0; i < 2 * LOG_NOTIFY_SLOTS; i++)
+      os_event_destroy(write_notify[i]);
+    ut_free(write_notify);
+    write_notify= flush_notify= NULL;
+  }
+
   rw_lock_free(&checkpoint_lock);
   mutex_free(&mutex);
   mutex_free(&write_mutex);
@@ -27,6 +27,7 @@ Created 9/20/1997 Heikki Tuuri
 
 #include "univ.i"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <string>
@@ -65,6 +66,10 @@ this must be less than srv_page_size as it is stored in the buffer pool */
 /** Read-ahead area in applying log records to file pages */
 #define RECV_READ_AHEAD_AREA	32
 
+/** Number of RECV_SCAN_SIZE segments of the redo log that are requested
+to be read ahead of the segment that is being parsed */
+#define RECV_SCAN_READ_AHEAD	16
+
 /** The recovery system */
 recv_sys_t	recv_sys;
 /** TRUE when applying redo log records during crash recovery; FALSE
@@ -864,6 +869,13 @@ void recv_sys_t::create()
 
 	addr_hash = hash_create(size / 512);
 	n_addrs = 0;
+	n_apply_batches = 0;
+	n_apply_threads = 0;
+	n_batch_pages = 0;
+	n_pages_applied = 0;
+	n_pages_read_ahead = 0;
+	apply_start_time = 0;
+	apply_end_time = 0;
 	progress_time = ut_time();
 	recv_max_page_lsn = 0;
 
@@ -1020,6 +1032,46 @@ bool log_t::files::read_log_seg(lsn_t* start_lsn, lsn_t end_lsn)
 	return(success);
 }
 
+/** Advise the operating system to start reading a log segment
+that read_log_seg() will be invoked on later.
+@param[in]	lsn	start of the segment
+@param[in]	len	length of the segment, in bytes */
+void log_t::files::read_ahead(lsn_t lsn, ulint len) const
+{
+#ifdef POSIX_FADV_WILLNEED
+	const lsn_t	offset = calc_lsn_offset(
+		ut_uint64_align_down(lsn, OS_FILE_LOG_BLOCK_SIZE));
+	const lsn_t	file_offset = offset % file_size;
+	ulint		file_no = ulint(offset / file_size);
+
+	if (file_offset + len > file_size) {
+		/* Do not bother to wrap around to the next file. */
+		len = ulint(file_size - file_offset);
+	}
+
+	mutex_enter(&fil_system.mutex);
+
+	if (const fil_space_t* space = fil_space_get_by_id(
+		    SRV_LOG_SPACE_FIRST_ID)) {
+		const fil_node_t* node = UT_LIST_GET_FIRST(space->chain);
+
+		while (node && file_no--) {
+			node = UT_LIST_GET_NEXT(chain, node);
+		}
+
+		if (node && node->is_open()) {
+			posix_fadvise(node->handle, off_t(file_offset),
+				      off_t(len), POSIX_FADV_WILLNEED);
+		}
+	}
+
+	mutex_exit(&fil_system.mutex);
+#else
+	(void) lsn;
+	(void) len;
+#endif /* POSIX_FADV_WILLNEED */
+}
+
 
 
 /********************************************************//**
@@ -1197,6 +1249,7 @@ static dberr_t recv_log_format_0_recover(lsn_t lsn, bool crypt)
 		= log_sys.lsn = log_sys.write_lsn
 		= log_sys.current_flush_lsn = log_sys.flushed_to_disk_lsn
 		= lsn;
+	log_sys.buf_ready_lsn = lsn;
 	log_sys.next_checkpoint_no = 0;
 	return(DB_SUCCESS);
 }
@@ -2089,11 +2142,14 @@ static void recv_recover_page(buf_block_t* block, mtr_t& mtr,
 
 	ut_ad(recv_addr->state == RECV_BEING_PROCESSED);
 	recv_addr->state = RECV_PROCESSED;
+	recv_sys.n_pages_applied++;
 
 	ut_a(recv_sys.n_addrs > 0);
 	if (ulint n = --recv_sys.n_addrs) {
 		if (recv_sys.report(time)) {
-			ib::info() << "To recover: " << n << " pages from log";
+			ib::info() << "To recover: " << n << " pages from log"
+				" using " << recv_sys.n_apply_threads
+				<< " threads";
 			service_manager_extend_timeout(
 				INNODB_EXTEND_TIMEOUT_INTERVAL, "To recover: " ULINTPF " pages from log", n);
 		}
@@ -2196,7 +2252,276 @@ static void recv_read_in_area(const page_id_t page_id)
 	mutex_enter(&recv_sys.mutex);
 }
 
+/** Issue asynchronous reads for all pages of the current batch that are
+not in the buffer pool, in ascending order of page identifiers. The log
+will be applied by the I/O completion threads, while the pages that
+reside in the buffer pool will be processed by recv_apply_part(). */
+static void recv_read_in_batch()
+{
+	ut_ad(mutex_own(&recv_sys.mutex));
+
+	typedef std::vector<page_id_t, ut_allocator<page_id_t> > page_ids_t;
+	page_ids_t	page_ids;
+
+	for (ulint i = 0; i < hash_get_n_cells(recv_sys.addr_hash); i++) {
+		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
+			     HASH_GET_FIRST(recv_sys.addr_hash, i));
+		     recv_addr;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+			if (recv_addr->state != RECV_NOT_PROCESSED
+			    || !UT_LIST_GET_LEN(recv_addr->rec_list)) {
+				continue;
+			}
+
+			const page_id_t page_id(recv_addr->space,
+						recv_addr->page_no);
+
+			if (!buf_page_peek(page_id)) {
+				recv_addr->state = RECV_BEING_READ;
+				page_ids.push_back(page_id);
+			}
+		}
+	}
+
+	if (page_ids.empty()) {
+		return;
+	}
+
+	std::sort(page_ids.begin(), page_ids.end());
+	recv_sys.n_pages_read_ahead += page_ids.size();
+
+	mutex_exit(&recv_sys.mutex);
+
+	ulint	page_nos[RECV_READ_AHEAD_AREA];
+	ulint	n = 0;
+
+	for (page_ids_t::const_iterator i = page_ids.begin();
+	     i != page_ids.end(); ) {
+		const ulint space_id = i->space();
+		page_nos[n++] = i->page_no();
+
+		if (++i == page_ids.end() || i->space() != space_id
+		    || n == RECV_READ_AHEAD_AREA) {
+			buf_read_recv_pages(false, space_id, page_nos, n);
+			n = 0;
+		}
+	}
+
+	mutex_enter(&recv_sys.mutex);
+}
+
+/** The pages of a recv_apply_hashed_log_recs() batch that were assigned
+to one applying thread */
+typedef std::vector<recv_addr_t*, ut_allocator<recv_addr_t*> > recv_addrs_t;
+
+/** Apply the stored log records to a page.
+@param[in,out]	recv_addr	page and its log records
+@param[in,out]	mtr		mini-transaction */
+static void recv_apply_page(recv_addr_t* recv_addr, mtr_t& mtr)
+{
+	ut_ad(mutex_own(&recv_sys.mutex));
+
+	if (!UT_LIST_GET_LEN(recv_addr->rec_list)) {
+ignore:
+		ut_a(recv_sys.n_addrs);
+		recv_sys.n_addrs--;
+		return;
+	}
+
+	switch (recv_addr->state) {
+	case RECV_BEING_READ:
+	case RECV_BEING_PROCESSED:
+	case RECV_PROCESSED:
+		return;
+	case RECV_DISCARDED:
+		goto ignore;
+	case RECV_NOT_PROCESSED:
+	case RECV_WILL_NOT_READ:
+		break;
+	}
+
+	const page_id_t page_id(recv_addr->space,
+				recv_addr->page_no);
+
+	if (recv_addr->state == RECV_NOT_PROCESSED) {
+apply:
+		mtr.start();
+		mtr.set_log_mode(MTR_LOG_NONE);
+		if (buf_block_t* block = buf_page_get_gen(
+			    page_id, 0, RW_X_LATCH, NULL,
+			    BUF_GET_IF_IN_POOL,
+			    __FILE__, __LINE__, &mtr, NULL)) {
+			buf_block_dbg_add_level(
+				block, SYNC_NO_ORDER_CHECK);
+			recv_recover_page(block, mtr,
+					  recv_addr);
+			ut_ad(mtr.has_committed());
+		} else {
+			mtr.commit();
+			recv_read_in_area(page_id);
+		}
+	} else {
+		mlog_init_t::init& i = mlog_init.last(page_id);
+		const lsn_t end_lsn = UT_LIST_GET_LAST(
+			recv_addr->rec_list)->end_lsn;
+
+		if (end_lsn < i.lsn) {
+			DBUG_LOG("ib_log", "skip log for page "
+				 << page_id
+				 << " LSN " << end_lsn
+				 << " < " << i.lsn);
+skip:
+			recv_addr->state = RECV_PROCESSED;
+			goto ignore;
+		}
+
+		fil_space_t* space = fil_space_acquire_for_io(
+			recv_addr->space);
+		if (!space) {
+			goto skip;
+		}
+
+		if (space->enable_lsn) {
+do_read:
+			space->release_for_io();
+			recv_addr->state = RECV_NOT_PROCESSED;
+			goto apply;
+		}
+
+		/* Determine if a tablespace could be
+		for an internal table for FULLTEXT INDEX.
+		For those tables, no MLOG_INDEX_LOAD record
+		used to be written when redo logging was
+		disabled. Hence, we cannot optimize
+		away page reads when crash-upgrading
+		from MariaDB versions before 10.4,
+		because all the redo log records for
+		initializing and modifying the page in
+		the past could be older than the page
+		in the data file.
+
+		The check is too broad, causing all
+		tables whose names start with FTS_ to
+		skip the optimization. */
+		if ((log_sys.log.format
+		     & ~LOG_HEADER_FORMAT_ENCRYPTED)
+		    != LOG_HEADER_FORMAT_10_4
+		    && strstr(space->name, "/FTS_")) {
+			goto do_read;
+		}
+
+		mtr.start();
+		mtr.set_log_mode(MTR_LOG_NONE);
+		buf_block_t* block = buf_page_create(
+			page_id, space->zip_size(), &mtr);
+		if (recv_addr->state == RECV_PROCESSED) {
+			/* The page happened to exist
+			in the buffer pool, or it was
+			just being read in. Before
+			buf_page_get_with_no_latch()
+			returned, all changes must have
+			been applied to the page already. */
+			mtr.commit();
+		} else {
+			i.created = true;
+			buf_block_dbg_add_level(
+				block, SYNC_NO_ORDER_CHECK);
+			mtr.x_latch_at_savepoint(0, block);
+			recv_recover_page(block, mtr,
+					  recv_addr, &i);
+			ut_ad(mtr.has_committed());
+		}
+
+		space->release_for_io();
+	}
+}
+
+/** Apply the stored log records to the pages of a partition.
+recv_sys.mutex is acquired for each page, not for traversing the
+partition, so that the threads will only wait for each other while
+the state of a page is being checked or updated.
+@param[in]	addrs	pages assigned to this thread */
+static void recv_apply_part(const recv_addrs_t& addrs)
+{
+	ut_ad(!mutex_own(&recv_sys.mutex));
+
+	mtr_t mtr;
+
+	for (recv_addrs_t::const_iterator i = addrs.begin();
+	     i != addrs.end(); ++i) {
+		mutex_enter(&recv_sys.mutex);
+		const bool abort = recv_sys.found_corrupt_log;
+		if (!abort) {
+			recv_apply_page(*i, mtr);
+		}
+		mutex_exit(&recv_sys.mutex);
+
+		if (abort) {
+			return;
+		}
+	}
+}
+
+/** Distribute the pages of the current batch between the applying threads.
+The pages whose log records are to be ignored are accounted for here.
+@param[out]	parts	pages of each thread
+@param[in]	n_parts	number of threads */
+static void recv_partition(recv_addrs_t* parts, ulint n_parts)
+{
+	ut_ad(mutex_own(&recv_sys.mutex));
+
+	ulint	n = 0;
+
+	for (ulint i = 0; i < hash_get_n_cells(recv_sys.addr_hash); i++) {
+		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
+			     HASH_GET_FIRST(recv_sys.addr_hash, i));
+		     recv_addr;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+			if (!UT_LIST_GET_LEN(recv_addr->rec_list)
+			    || recv_addr->state == RECV_DISCARDED) {
+				ut_a(recv_sys.n_addrs);
+				recv_sys.n_addrs--;
+				continue;
+			}
+
+			switch (recv_addr->state) {
+			case RECV_NOT_PROCESSED:
+			case RECV_WILL_NOT_READ:
+				parts[n++ % n_parts].push_back(recv_addr);
+				continue;
+			default:
+				/* Being read in, or already applied
+				by an I/O completion thread. */
+				continue;
+			}
+		}
+	}
+}
+
+/** Thread for applying a partition of the current batch
+@param[in]	arg	pages to apply, recv_addrs_t
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(void* arg)
+{
+	my_thread_init();
+
+	recv_apply_part(*static_cast<const recv_addrs_t*>(arg));
+
+	my_thread_end();
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /** Apply the hash table of stored log records to persistent data pages.
+With innodb_log_apply_threads>1, the pages are distributed between
+the calling thread and srv_n_log_apply_threads-1 recv_apply_thread
+before any log is applied.
 @param[in]	last_batch	whether the change buffer merge will be
 				performed as part of the operation */
 void recv_apply_hashed_log_recs(bool last_batch)
@@ -2257,130 +2582,49 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
-	mtr_t mtr;
-
-	for (ulint i = 0; i < hash_get_n_cells(recv_sys.addr_hash); i++) {
-		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
-			     HASH_GET_FIRST(recv_sys.addr_hash, i));
-		     recv_addr;
-		     recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_NEXT(addr_hash, recv_addr))) {
-			if (!UT_LIST_GET_LEN(recv_addr->rec_list)) {
-ignore:
-				ut_a(recv_sys.n_addrs);
-				recv_sys.n_addrs--;
-				continue;
-			}
+	const ulint n_threads = std::max<ulint>(
+		1, std::min<ulint>(srv_n_log_apply_threads,
+				   hash_get_n_cells(recv_sys.addr_hash)));
+	recv_sys.n_apply_threads = n_threads;
+	recv_sys.n_apply_batches++;
+	recv_sys.n_batch_pages = recv_sys.n_addrs;
+	if (!recv_sys.apply_start_time) {
+		recv_sys.apply_start_time = ut_time();
+	}
 
-			switch (recv_addr->state) {
-			case RECV_BEING_READ:
-			case RECV_BEING_PROCESSED:
-			case RECV_PROCESSED:
-				continue;
-			case RECV_DISCARDED:
-				goto ignore;
-			case RECV_NOT_PROCESSED:
-			case RECV_WILL_NOT_READ:
-				break;
-			}
+	recv_read_in_batch();
 
-			const page_id_t page_id(recv_addr->space,
-						recv_addr->page_no);
+	recv_addrs_t* parts = UT_NEW_ARRAY_NOKEY(recv_addrs_t, n_threads);
+	recv_partition(parts, n_threads);
+	mutex_exit(&recv_sys.mutex);
 
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-apply:
-				mtr.start();
-				mtr.set_log_mode(MTR_LOG_NONE);
-				if (buf_block_t* block = buf_page_get_gen(
-					    page_id, 0, RW_X_LATCH, NULL,
-					    BUF_GET_IF_IN_POOL,
-					    __FILE__, __LINE__, &mtr, NULL)) {
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
-					recv_recover_page(block, mtr,
-							  recv_addr);
-					ut_ad(mtr.has_committed());
-				} else {
-					mtr.commit();
-					recv_read_in_area(page_id);
-				}
-			} else {
-				mlog_init_t::init& i = mlog_init.last(page_id);
-				const lsn_t end_lsn = UT_LIST_GET_LAST(
-					recv_addr->rec_list)->end_lsn;
-
-				if (end_lsn < i.lsn) {
-					DBUG_LOG("ib_log", "skip log for page "
-						 << page_id
-						 << " LSN " << end_lsn
-						 << " < " << i.lsn);
-skip:
-					recv_addr->state = RECV_PROCESSED;
-					goto ignore;
-				}
+	os_thread_id_t* threads = NULL;
 
-				fil_space_t* space = fil_space_acquire_for_io(
-					recv_addr->space);
-				if (!space) {
-					goto skip;
-				}
+	if (n_threads > 1) {
+		threads = static_cast<os_thread_id_t*>(
+			ut_malloc_nokey((n_threads - 1) * sizeof *threads));
 
-				if (space->enable_lsn) {
-do_read:
-					space->release_for_io();
-					recv_addr->state = RECV_NOT_PROCESSED;
-					goto apply;
-				}
-
-				/* Determine if a tablespace could be
-				for an internal table for FULLTEXT INDEX.
-				For those tables, no MLOG_INDEX_LOAD record
-				used to be written when redo logging was
-				disabled. Hence, we cannot optimize
-				away page reads when crash-upgrading
-				from MariaDB versions before 10.4,
-				because all the redo log records for
-				initializing and modifying the page in
-				the past could be older than the page
-				in the data file.
-
-				The check is too broad, causing all
-				tables whose names start with FTS_ to
-				skip the optimization. */
-				if ((log_sys.log.format
-				     & ~LOG_HEADER_FORMAT_ENCRYPTED)
-				    != LOG_HEADER_FORMAT_10_4
-				    && strstr(space->name, "/FTS_")) {
-					goto do_read;
-				}
+		for (ulint i = 1; i < n_threads; i++) {
+			os_thread_create(recv_apply_thread, &parts[i],
+					 &threads[i - 1]);
+		}
+	}
 
-				mtr.start();
-				mtr.set_log_mode(MTR_LOG_NONE);
-				buf_block_t* block = buf_page_create(
-					page_id, space->zip_size(), &mtr);
-				if (recv_addr->state == RECV_PROCESSED) {
-					/* The page happened to exist
-					in the buffer pool, or it was
-					just being read in. Before
-					buf_page_get_with_no_latch()
-					returned, all changes must have
-					been applied to the page already. */
-					mtr.commit();
-				} else {
-					i.created = true;
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
-					mtr.x_latch_at_savepoint(0, block);
-					recv_recover_page(block, mtr,
-							  recv_addr, &i);
-					ut_ad(mtr.has_committed());
-				}
+	recv_apply_part(parts[0]);
 
-				space->release_for_io();
-			}
+	if (threads) {
+		for (ulint i = 1; i < n_threads; i++) {
+			os_thread_join(threads[i - 1]);
 		}
+
+		ut_free(threads);
 	}
 
+	UT_DELETE_ARRAY(parts);
+	mutex_enter(&recv_sys.mutex);
+
+	mtr_t mtr;
+
 	/* Wait until all the pages have been processed */
 
 	while (recv_sys.n_addrs != 0) {
@@ -2437,12 +2681,42 @@ void recv_apply_hashed_log_recs(bool last_batch)
 
 	recv_sys.apply_log_recs = false;
 	recv_sys.apply_batch_on = false;
+	recv_sys.apply_end_time = ut_time();
 
 	recv_sys.empty();
 
 	mutex_exit(&recv_sys.mutex);
 }
 
+/** Print the progress of applying the redo log to SHOW ENGINE INNODB STATUS.
+@param[in,out]	file	output stream */
+void recv_print(FILE* file)
+{
+	if (!recv_sys.n_apply_batches) {
+		return;
+	}
+
+	if (recv_sys.apply_batch_on) {
+		fprintf(file,
+			"Applying redo log batch " ULINTPF ": "
+			ULINTPF " of " ULINTPF " pages remaining, "
+			ULINTPF " threads\n",
+			recv_sys.n_apply_batches, recv_sys.n_addrs,
+			recv_sys.n_batch_pages, recv_sys.n_apply_threads);
+	} else {
+		fprintf(file,
+			"Redo log applied to " ULINTPF " pages in "
+			ULINTPF " batches, %.0f seconds, "
+			ULINTPF " threads, "
+			ULINTPF " pages read ahead\n",
+			recv_sys.n_pages_applied, recv_sys.n_apply_batches,
+			difftime(recv_sys.apply_end_time,
+				 recv_sys.apply_start_time),
+			recv_sys.n_apply_threads,
+			recv_sys.n_pages_read_ahead);
+	}
+}
+
 /** Tries to parse a single log record.
 @param[out]	type		log record type
 @param[in]	ptr		pointer to a buffer
@@ -3308,7 +3582,19 @@ recv_group_scan_log_recs(
 	log_sys.log.scanned_lsn = end_lsn = *contiguous_lsn =
 		ut_uint64_align_down(*contiguous_lsn, OS_FILE_LOG_BLOCK_SIZE);
 
+	/* Keep the operating system reading the redo log ahead of
+	the parsing, so that the parsing does not wait for each
+	read_log_seg() to complete. */
+	lsn_t	read_ahead_lsn = end_lsn;
+
 	do {
+		while (read_ahead_lsn < end_lsn
+		       + RECV_SCAN_READ_AHEAD * RECV_SCAN_SIZE) {
+			log_sys.log.read_ahead(read_ahead_lsn,
+					       RECV_SCAN_SIZE);
+			read_ahead_lsn += RECV_SCAN_SIZE;
+		}
+
 		if (last_phase && store_to_hash == STORE_NO) {
 			store_to_hash = STORE_IF_EXISTS;
 			/* We must not allow change buffer
@@ -3782,6 +4068,7 @@ recv_recovery_from_checkpoint_start(lsn_t flush_lsn)
 	log_sys.buf_free = ulong(log_sys.lsn % OS_FILE_LOG_BLOCK_SIZE);
 	log_sys.buf_next_to_write = log_sys.buf_free;
 	log_sys.write_lsn = log_sys.lsn;
+	log_sys.buf_ready_lsn = log_sys.lsn;
 
 	log_sys.last_checkpoint_lsn = checkpoint_lsn;
 
@@ -411,6 +411,11 @@ class mtr_t::Command {
 	@param[in]	len	number of bytes to write */
 	void finish_write(ulint len);
 
+	/** Reserve space for the redo log records in the redo log buffer.
+	@param[in]	len	number of bytes to write
+	@return start of the reserved area in log_sys.buf */
+	byte* reserve_write(ulint len);
+
 private:
 	/** Prepare to write the mini-transaction log to the redo log buffer.
 	@return number of bytes to write in finish_write() */
@@ -455,6 +460,26 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to space reserved in the redo log buffer */
+struct mtr_write_reserved_t {
+	/** Constructor.
+	@param[in]	ptr	start of the area reserved by
+				log_reserve_low() */
+	explicit mtr_write_reserved_t(byte* ptr) : m_ptr(ptr) {}
+
+	/** Append a block to the reserved area.
+	@return whether the appending should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		m_ptr = log_write_reserved(m_ptr, block->begin(),
+					   block->used());
+		return(true);
+	}
+
+	/** Current position in the reserved area */
+	byte*	m_ptr;
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -849,6 +874,29 @@ mtr_t::Command::finish_write(
 	m_end_lsn = log_close();
 }
 
+/** Reserve space for the redo log records in the redo log buffer.
+The records will be copied by execute() after log_sys.mutex has been
+released.
+@param[in]	len	number of bytes to write
+@return start of the reserved area in log_sys.buf */
+byte*
+mtr_t::Command::reserve_write(
+	ulint	len)
+{
+	ut_ad(m_impl->m_log_mode == MTR_LOG_ALL);
+	ut_ad(log_mutex_own());
+	ut_ad(m_impl->m_log.size() == len);
+	ut_ad(len > 0);
+
+	m_start_lsn = log_reserve_and_open(len);
+
+	byte*	ptr = log_reserve_low(len);
+
+	m_end_lsn = log_close();
+
+	return(ptr);
+}
+
 /** Release the latches and blocks acquired by this mini-transaction */
 void
 mtr_t::Command::release_all()
@@ -892,25 +940,58 @@ mtr_t::Command::execute()
 {
 	ut_ad(m_impl->m_log_mode != MTR_LOG_NONE);
 
-	if (const ulint len = prepare_write()) {
-		finish_write(len);
-	}
+	const ulint	len = prepare_write();
 
-	if (m_impl->m_made_dirty) {
-		log_flush_order_mutex_enter();
-	}
+	if (!len) {
+		/* No redo log was written. Wait for any concurrent
+		mtr_t::commit() to insert its pages to the flush lists,
+		so that our pages will be inserted in the LSN order. */
+		log_sys.wait_ready(m_start_lsn);
+
+		if (m_impl->m_made_dirty) {
+			log_flush_order_mutex_enter();
+		}
+
+		/* It is now safe to release the log mutex because the
+		flush_order mutex will ensure that we are the first one
+		to insert into the flush list. */
+		log_mutex_exit();
 
-	/* It is now safe to release the log mutex because the
-	flush_order mutex will ensure that we are the first one
-	to insert into the flush list. */
-	log_mutex_exit();
+		m_impl->m_mtr->m_commit_lsn = m_end_lsn;
 
-	m_impl->m_mtr->m_commit_lsn = m_end_lsn;
+		release_blocks();
 
-	release_blocks();
+		if (m_impl->m_made_dirty) {
+			log_flush_order_mutex_exit();
+		}
+	} else {
+		mtr_write_reserved_t	write_log(reserve_write(len));
+
+		/* The log buffer space has been reserved. Other threads
+		may reserve further space while we are copying. */
+		log_mutex_exit();
+
+		m_impl->m_log.for_each_block(write_log);
+		ut_ad(ut_align_offset(write_log.m_ptr,
+				      OS_FILE_LOG_BLOCK_SIZE)
+		      == m_end_lsn % OS_FILE_LOG_BLOCK_SIZE);
+
+		m_impl->m_mtr->m_commit_lsn = m_end_lsn;
+
+		/* Insert the pages to the flush lists in the LSN order.
+		The preceding mini-transactions must also have finished
+		copying their log before we advance log_sys.buf_ready_lsn. */
+		log_sys.wait_ready(m_start_lsn);
+
+		if (m_impl->m_made_dirty) {
+			log_flush_order_mutex_enter();
+			release_blocks();
+			log_flush_order_mutex_exit();
+		} else {
+			release_blocks();
+		}
 
-	if (m_impl->m_made_dirty) {
-		log_flush_order_mutex_exit();
+		log_sys.set_ready(m_end_lsn);
 	}
 
 	release_latches();
@@ -182,6 +182,7 @@ will mark their views as closed but not actually free their views.
 */
 inline void ReadView::snapshot(trx_t *trx)
 {
+  m_erased= trx_sys.get_rw_trx_hash_erased();
   trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
   std::sort(m_ids.begin(), m_ids.end());
   m_up_limit_id= m_ids.empty() ? m_low_limit_id : m_ids.front();
@@ -209,8 +210,24 @@ void ReadView::open(trx_t *trx)
     if (srv_read_only_mode)
       return;
     /*
-      Reuse closed view if there were no read-write transactions since (and at)
-      its creation time.
+      Reuse closed view if no read-write transaction was registered,
+      serialised or deregistered since its creation time. Then rw_trx_hash
+      still has exactly the contents the snapshot was taken from, and a new
+      snapshot would be identical. This makes opening a view O(1) for
+      repeated consistent reads while there is no write activity, no matter
+      how many transactions are active.
+
+      Deregistration increments trx_sys.get_rw_trx_hash_erased() after
+      removing the transaction from rw_trx_hash. A view that saw the old
+      value will thus not be reused after deregister_rw() returns, that is,
+      before the commit can be acknowledged.
+
+      Unlike an empty view, a view that lists active transactions needs
+      their undo logs. If one of them committed and was purged before the
+      view became visible to purge, the view would access freed undo log
+      records. That is why the view is made visible first and validated
+      again afterwards. If the check fails, the view is closed again and
+      a new snapshot is taken as usual.
 
       Original comment states: there is an inherent race here between purge
       and this thread.
@@ -235,9 +252,34 @@ void ReadView::open(trx_t *trx)
       may get started, committed and purged meanwhile. It is acceptable as
       well, since this view doesn't see it.
     */
-    if (trx_is_autocommit_non_locking(trx) && m_ids.empty() &&
-        m_low_limit_id == trx_sys.get_max_trx_id())
-      goto reopen;
+    if (m_low_limit_id == trx_sys.get_max_trx_id() &&
+        m_erased == trx_sys.get_rw_trx_hash_erased())
+    {
+      if (m_ids.empty())
+      {
+        srv_stats.read_views_reused.inc();
+        goto reopen;
+      }
+      /*
+        The RELEASE store publishes m_creator_trx_id together with the
+        state, like at reopen below. The loads below must not be
+        reordered before the store; release/acquire alone does not order
+        a store before a later load, hence the full fence. It pairs with
+        the RELEASE increment in deregister_rw(), which happens before
+        the commit becomes visible to purge: either purge sees this view,
+        or the ACQUIRE loads below see the increment.
+      */
+      m_creator_trx_id= trx->id;
+      m_state.store(READ_VIEW_STATE_OPEN, std::memory_order_release);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (m_low_limit_id == trx_sys.get_max_trx_id() &&
+          m_erased == trx_sys.get_rw_trx_hash_erased())
+      {
+        srv_stats.read_views_reused.inc();
+        return;
+      }
+      m_state.store(READ_VIEW_STATE_CLOSED, std::memory_order_relaxed);
+    }
 
     /*
       Can't reuse view, take new snapshot.
@@ -261,6 +303,7 @@ void ReadView::open(trx_t *trx)
   }
 
   snapshot(trx);
+  srv_stats.read_view_snapshots.inc();
 reopen:
   m_creator_trx_id= trx->id;
   m_state.store(READ_VIEW_STATE_OPEN, std::memory_order_release);
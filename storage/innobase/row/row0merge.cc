@@ -870,7 +870,19 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++ && dup->table) {
+		if (dup->reported) {
+			/* Indexes are being built concurrently.
+			Only the first one to find a duplicate may
+			write to table->record[0]. */
+			const dict_index_t*	none = NULL;
+
+			if (!dup->reported->compare_exchange_strong(
+				    none, dup->index)) {
+				return;
+			}
+		}
+
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
@@ -1649,6 +1661,649 @@ row_geo_field_is_valid(
 	return(true);
 }
 
+/** Shared state of a parallel scan of the clustered index, for adding
+secondary indexes without rebuilding the table. The clustered index is
+split into key ranges, which the threads take in turn. Each thread sorts
+its own buffers and appends them as runs to the shared merge files. */
+struct row_merge_pscan_t
+{
+	/** transaction */
+	trx_t*			trx;
+	/** MySQL table object, for reporting duplicates */
+	struct TABLE*		table;
+	/** the table */
+	const dict_table_t*	old_table;
+	/** whether the indexes are being created online */
+	bool			online;
+	/** indexes to be created */
+	dict_index_t**		index;
+	/** MySQL key numbers of index[] */
+	const ulint*		key_numbers;
+	/** number of indexes to create */
+	ulint			n_index;
+	/** merge files of index[] */
+	merge_file_t*		files;
+	/** temporary file handle */
+	pfs_os_file_t*		tmpfd;
+	/** location of the temporary files */
+	const char*		path;
+	/** performance schema accounting object */
+	ut_stage_alter_t*	stage;
+	/** percent of task weight of the scan out of the total */
+	double			pct_cost;
+	/** estimated number of rows in the table */
+	ib_uint64_t		table_total_rows;
+	/** boundaries of the key ranges; range i consists of the keys
+	from bounds[i - 1] (inclusive) to bounds[i] (exclusive) */
+	const dtuple_t**	bounds;
+	/** number of elements in bounds[] */
+	ulint			n_bounds;
+	/** the next range to scan */
+	Atomic_counter<ulint>	next_range;
+	/** whether err has been set */
+	std::atomic<bool>	failed;
+
+	/** protects files, tmpfd, stage, n_rows, err, and
+	trx->error_key_num and table->record[0] */
+	OSMutex			mutex;
+	/** number of rows read so far */
+	ib_uint64_t		n_rows;
+	/** the first error */
+	dberr_t			err;
+
+	/** Note an error.
+	@param[in]	error		error code
+	@param[in]	key_num		value of trx->error_key_num */
+	void fail(dberr_t error, ulint key_num)
+	{
+		mutex.enter();
+		if (err == DB_SUCCESS) {
+			err = error;
+			trx->error_key_num = key_num;
+			failed = true;
+		}
+		mutex.exit();
+	}
+};
+
+/** Determine the key ranges for a parallel scan of a clustered index.
+The boundaries are the node pointers of the highest level of the tree
+that contains at least the requested number of them.
+@param[in]	index	clustered index
+@param[in]	n	requested number of ranges
+@param[in,out]	heap	memory heap for the boundaries
+@param[out]	bounds	boundaries, in ascending order; empty if the
+index consists of a single page */
+static
+void
+row_merge_pscan_bounds(
+	dict_index_t*			index,
+	ulint				n,
+	mem_heap_t*			heap,
+	std::vector<const dtuple_t*>&	bounds)
+{
+	mtr_t				mtr;
+	std::vector<const buf_block_t*>	blocks;
+	std::vector<ulint>		children;
+	const ulint			n_uniq = dict_index_get_n_unique(index);
+	mem_heap_t*			offsets_heap = mem_heap_create(1024);
+
+	ut_ad(index->is_primary());
+
+	mtr.start();
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	const buf_block_t*	root = btr_root_block_get(
+		index, RW_S_LATCH, &mtr);
+
+	if (root == NULL) {
+		goto func_exit;
+	}
+
+	blocks.push_back(root);
+
+	for (ulint level = btr_page_get_level(root->frame);
+	     level > 0; level--) {
+		bounds.clear();
+		children.clear();
+
+		for (std::vector<const buf_block_t*>::const_iterator b
+			     = blocks.begin();
+		     b != blocks.end(); ++b) {
+			for (const rec_t* rec = page_rec_get_next_const(
+				     page_get_infimum_rec((*b)->frame));
+			     !page_rec_is_supremum(rec);
+			     rec = page_rec_get_next_const(rec)) {
+				ulint*	offsets = rec_get_offsets(
+					rec, index, NULL, false,
+					ULINT_UNDEFINED, &offsets_heap);
+
+				children.push_back(
+					btr_node_ptr_get_child_page_no(
+						rec, offsets));
+
+				if (rec_get_info_bits(
+					    rec, page_rec_is_comp(rec))
+				    & REC_INFO_MIN_REC_FLAG) {
+					continue;
+				}
+
+				bounds.push_back(dict_index_build_data_tuple(
+						 rec, index, false, n_uniq,
+						 heap));
+			}
+
+			mem_heap_empty(offsets_heap);
+		}
+
+		if (level == 1 || bounds.size() + 1 >= n) {
+			break;
+		}
+
+		/* Descend to the next level. */
+		blocks.clear();
+
+		for (std::vector<ulint>::const_iterator c = children.begin();
+		     c != children.end(); ++c) {
+			const buf_block_t*	block = btr_block_get(
+				page_id_t(index->table->space_id, *c),
+				index->table->space->zip_size(),
+				RW_S_LATCH, index, &mtr);
+
+			if (block == NULL) {
+				bounds.clear();
+				goto func_exit;
+			}
+
+			blocks.push_back(block);
+		}
+	}
+
+func_exit:
+	mtr.commit();
+	mem_heap_free(offsets_heap);
+}
+
+/** Sort a buffer of a parallel clustered index scan, and append it
+to the merge file.
+@param[in,out]	scan		parallel scan
+@param[in]	i		index number
+@param[in,out]	buf		sort buffer
+@param[in,out]	block		file buffer
+@param[in,out]	crypt_block	encrypted file buffer, or NULL
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_pscan_write(
+	row_merge_pscan_t*	scan,
+	ulint			i,
+	row_merge_buf_t*	buf,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block)
+{
+	merge_file_t*	file = &scan->files[i];
+
+	if (dict_index_is_unique(buf->index)) {
+		/* Count the duplicates first; table->record[0] is
+		shared by all threads. */
+		row_merge_dup_t	dup = {buf->index, NULL, NULL, 0, NULL};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			scan->mutex.enter();
+			if (scan->err == DB_SUCCESS) {
+				dup.table = scan->table;
+				dup.n_dup = 0;
+				row_merge_buf_sort(buf, &dup);
+				ut_ad(dup.n_dup);
+				scan->err = DB_DUPLICATE_KEY;
+				scan->trx->error_key_num
+					= scan->key_numbers[i];
+				scan->failed = true;
+			}
+			scan->mutex.exit();
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	row_merge_buf_write(buf, file, block);
+
+	scan->mutex.enter();
+	const bool	created = row_merge_file_create_if_needed(
+		file, scan->tmpfd, 0, scan->path);
+	const ulint	offset = file->offset++;
+	file->n_rec += buf->n_tuples;
+	scan->mutex.exit();
+
+	if (!created) {
+		scan->fail(DB_OUT_OF_MEMORY, i);
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	if (!row_merge_write(file->fd, offset, block, crypt_block,
+			     scan->old_table->space_id)) {
+		scan->fail(DB_TEMP_FILE_WRITE_FAIL, i);
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+	return(DB_SUCCESS);
+}
+
+/** Account for the records of a page that was read by a parallel
+clustered index scan, and check whether the scan should stop.
+@param[in,out]	scan	parallel scan
+@param[in,out]	n_recs	number of records read since the last call
+@param[in,out]	n_rows	number of rows read since the last call
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_pscan_page(
+	row_merge_pscan_t*	scan,
+	ulint&			n_recs,
+	ulint&			n_rows)
+{
+	scan->mutex.enter();
+
+	for (; n_recs; n_recs--) {
+		scan->stage->n_pk_recs_inc();
+	}
+
+	scan->stage->inc();
+	scan->n_rows += n_rows;
+	n_rows = 0;
+
+	/* presenting 10.12% as 1012 integer */
+	onlineddl_pct_progress = ulint(
+		(scan->n_rows >= scan->table_total_rows
+		 ? scan->pct_cost
+		 : scan->pct_cost * double(scan->n_rows)
+		 / double(scan->table_total_rows)) * 100);
+
+	scan->mutex.exit();
+
+	if (scan->failed) {
+		return(DB_ERROR);
+	}
+
+	if (UNIV_UNLIKELY(trx_is_interrupted(scan->trx))) {
+		scan->fail(DB_INTERRUPTED, 0);
+		return(DB_INTERRUPTED);
+	}
+
+	if (!scan->old_table->is_readable()) {
+		scan->fail(DB_DECRYPTION_FAILED, 0);
+		return(DB_DECRYPTION_FAILED);
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Scan a key range of the clustered index, and buffer the index
+entries for the indexes to be created.
+@param[in,out]	scan		parallel scan
+@param[in]	r		range number
+@param[in,out]	merge_buf	sort buffers
+@param[in,out]	block		file buffer
+@param[in,out]	crypt_block	encrypted file buffer, or NULL
+@param[in,out]	row_heap	memory heap for rows
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_pscan_range(
+	row_merge_pscan_t*	scan,
+	ulint			r,
+	row_merge_buf_t**	merge_buf,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	mem_heap_t*		row_heap)
+{
+	trx_t*			trx = scan->trx;
+	const dict_table_t*	table = scan->old_table;
+	dict_index_t*		clust_index = dict_table_get_first_index(
+		table);
+	const dtuple_t*		low = r ? scan->bounds[r - 1] : NULL;
+	const dtuple_t*		high = r < scan->n_bounds
+		? scan->bounds[r] : NULL;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+	ulint			n_recs = 0;
+	ulint			n_rows = 0;
+	dberr_t			err = DB_SUCCESS;
+	/* whether the page end at the cursor has been accounted for */
+	bool			yielded = false;
+
+	mtr.start();
+
+	if (low) {
+		/* Position the cursor before the first record of
+		the range. */
+		btr_pcur_open(clust_index, low, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	} else {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	}
+
+	for (;;) {
+		mem_heap_empty(row_heap);
+
+		if (!btr_pcur_move_to_next(&pcur, &mtr)) {
+			break;
+		}
+
+		if (btr_pcur_is_after_last_on_page(&pcur)) {
+			if (yielded) {
+				/* Do not yield again before moving to
+				the next page. */
+				yielded = false;
+				continue;
+			}
+
+			err = row_merge_pscan_page(scan, n_recs, n_rows);
+
+			if (err != DB_SUCCESS) {
+				break;
+			}
+
+			if (clust_index->lock.waiters.load(
+				    std::memory_order_relaxed)) {
+				/* Let the waiters on the clustered index
+				tree lock proceed; see the yield in
+				row_merge_read_clustered_index(). */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr.commit();
+				os_thread_yield();
+				mtr.start();
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+				yielded = true;
+			}
+
+			continue;
+		}
+
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+
+		if (page_rec_is_infimum(rec)
+		    || rec_is_metadata(rec, *clust_index)) {
+			continue;
+		}
+
+		ulint*	offsets = rec_get_offsets(
+			rec, clust_index, NULL, true, ULINT_UNDEFINED,
+			&row_heap);
+
+		if (high && cmp_dtuple_rec(high, rec, offsets) <= 0) {
+			break;
+		}
+
+		n_recs++;
+
+		/* Apply the same visibility rules as
+		row_merge_read_clustered_index(). */
+		if (scan->online) {
+			trx_id_t	rec_trx_id = row_get_rec_trx_id(
+				rec, clust_index, offsets);
+
+			if (!trx->read_view.changes_visible(
+				    rec_trx_id, table->name)) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					&trx->read_view, &row_heap,
+					row_heap, &old_vers, NULL);
+
+				if (!old_vers) {
+					continue;
+				}
+
+				rec = old_vers;
+			}
+		}
+
+		if (rec_get_deleted_flag(rec, dict_table_is_comp(table))) {
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row_ext_t*	ext;
+		dtuple_t*	row = row_build_w_add_vcol(
+			ROW_COPY_POINTERS, clust_index, rec, offsets,
+			table, NULL, NULL, NULL, &ext, row_heap);
+
+		n_rows++;
+
+		for (ulint i = 0; i < scan->n_index; i++) {
+			row_merge_buf_t*	buf = merge_buf[i];
+			doc_id_t		doc_id = 0;
+			ulint			rows_added = row_merge_buf_add(
+				buf, NULL, table, table, NULL, row, ext,
+				&doc_id, NULL, &err, NULL, NULL, trx);
+
+			if (!rows_added && err == DB_SUCCESS) {
+				/* The buffer is full. */
+				err = row_merge_pscan_write(
+					scan, i, buf, block, crypt_block);
+
+				if (err != DB_SUCCESS) {
+					goto func_exit;
+				}
+
+				merge_buf[i] = buf = row_merge_buf_empty(buf);
+
+				/* An empty buffer should have enough
+				room for at least one record. */
+				rows_added = row_merge_buf_add(
+					buf, NULL, table, table, NULL,
+					row, ext, &doc_id, NULL, &err,
+					NULL, NULL, trx);
+				ut_a(rows_added);
+			}
+
+			if (err != DB_SUCCESS) {
+				scan->fail(err, i);
+				goto func_exit;
+			}
+		}
+	}
+
+func_exit:
+	if (mtr.is_active()) {
+		mtr.commit();
+	}
+
+	btr_pcur_close(&pcur);
+
+	if (n_recs || n_rows) {
+		if (dberr_t e = row_merge_pscan_page(scan, n_recs, n_rows)) {
+			if (err == DB_SUCCESS) {
+				err = e;
+			}
+		}
+	}
+
+	return(err);
+}
+
+/** Thread of a parallel clustered index scan.
+@param[in,out]	arg	row_merge_pscan_t
+@return OS_THREAD_DUMMY_RETURN */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_pscan_thread)(void* arg)
+{
+	row_merge_pscan_t*	scan = static_cast<row_merge_pscan_t*>(arg);
+	const ulint		n_index = scan->n_index;
+	row_merge_buf_t**	merge_buf = static_cast<row_merge_buf_t**>(
+		ut_malloc_nokey(n_index * sizeof *merge_buf));
+	mem_heap_t*		row_heap = mem_heap_create(
+		sizeof(mrec_buf_t));
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	block = alloc.allocate_large(
+		srv_sort_buf_size, &block_pfx);
+	row_merge_block_t*	crypt_block = NULL;
+	dberr_t			err = DB_SUCCESS;
+
+	for (ulint i = 0; i < n_index; i++) {
+		merge_buf[i] = row_merge_buf_create(scan->index[i]);
+	}
+
+	if (log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(
+			srv_sort_buf_size + WOLFSSL_PAD_SIZE, &crypt_pfx);
+	}
+
+	if (!block || (log_tmp_is_encrypted() && !crypt_block)) {
+		scan->fail(DB_OUT_OF_MEMORY, 0);
+		goto func_exit;
+	}
+
+	for (ulint r; err == DB_SUCCESS
+		     && (r = scan->next_range++) <= scan->n_bounds; ) {
+		err = row_merge_pscan_range(
+			scan, r, merge_buf, block, crypt_block, row_heap);
+	}
+
+	/* Write out the remaining entries. */
+	for (ulint i = 0; err == DB_SUCCESS && i < n_index; i++) {
+		if (merge_buf[i]->n_tuples) {
+			err = row_merge_pscan_write(
+				scan, i, merge_buf[i], block, crypt_block);
+		}
+	}
+
+func_exit:
+	for (ulint i = 0; i < n_index; i++) {
+		row_merge_buf_free(merge_buf[i]);
+	}
+
+	ut_free(merge_buf);
+	mem_heap_free(row_heap);
+
+	if (block) {
+		alloc.deallocate_large(block, &block_pfx, srv_sort_buf_size);
+	}
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx,
+				       srv_sort_buf_size + WOLFSSL_PAD_SIZE);
+	}
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Read the clustered index in parallel, and create temporary files
+containing the index entries for secondary indexes to be created
+without rebuilding the table.
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table object, for reporting duplicates
+@param[in]	old_table	table where rows are read from
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	stage		performance schema accounting object
+@param[in]	pct_cost	percent of task weight out of total alter job
+@param[in]	bounds		boundaries of the key ranges to scan
+@param[in]	n_threads	number of threads to use
+@return DB_SUCCESS or error */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+	trx_t*					trx,
+	struct TABLE*				table,
+	const dict_table_t*			old_table,
+	bool					online,
+	dict_index_t**				index,
+	merge_file_t*				files,
+	const ulint*				key_numbers,
+	ulint					n_index,
+	pfs_os_file_t*				tmpfd,
+	ut_stage_alter_t*			stage,
+	double					pct_cost,
+	const std::vector<const dtuple_t*>&	bounds,
+	ulint					n_threads)
+{
+	row_merge_pscan_t	scan;
+
+	scan.trx = trx;
+	scan.table = table;
+	scan.old_table = old_table;
+	scan.online = online;
+	scan.index = index;
+	scan.key_numbers = key_numbers;
+	scan.n_index = n_index;
+	scan.files = files;
+	scan.tmpfd = tmpfd;
+	scan.path = thd_innodb_tmpdir(trx->mysql_thd);
+	scan.stage = stage;
+	scan.pct_cost = pct_cost;
+	scan.table_total_rows = std::max<ib_uint64_t>(
+		1, dict_table_get_n_rows(old_table));
+	scan.bounds = const_cast<const dtuple_t**>(&bounds[0]);
+	scan.n_bounds = bounds.size();
+	scan.next_range = 0;
+	scan.failed = false;
+	scan.n_rows = 0;
+	scan.err = DB_SUCCESS;
+	scan.mutex.init();
+
+	if (innodb_log_optimize_ddl) {
+		trx->set_flush_observer(old_table->space, stage);
+	}
+
+	n_threads = std::min(n_threads, bounds.size() + 1);
+
+	std::vector<os_thread_id_t>	threads(n_threads);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		os_thread_create(row_merge_pscan_thread, &scan, &threads[i]);
+	}
+
+	DEBUG_SYNC_C("row_merge_pscan_running");
+
+	for (ulint i = 0; i < n_threads; i++) {
+		os_thread_join(threads[i]);
+	}
+
+	scan.mutex.destroy();
+
+	if (scan.err == DB_SUCCESS && online) {
+		/* Note the newest transaction that modified each index
+		when the scan was completed. We prevent older readers
+		from accessing the index, to ensure read consistency. */
+		for (ulint i = 0; i < n_index; i++) {
+			rw_lock_x_lock(dict_index_get_lock(index[i]));
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			trx_id_t max_trx_id = row_log_get_max_trx(index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			rw_lock_x_unlock(dict_index_get_lock(index[i]));
+		}
+	}
+
+	return(scan.err);
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -1764,6 +2419,42 @@ row_merge_read_clustered_index(
 
 	trx->op_info = "reading clustered index";
 
+	if (srv_alter_scan_threads > 1 && old_table == new_table
+	    && !fts_sort_idx && !add_v) {
+		bool	parallel = true;
+
+		for (ulint i = 0; i < n_index; i++) {
+			if (index[i]->is_spatial() || index[i]->has_virtual()) {
+				parallel = false;
+				break;
+			}
+		}
+
+		if (parallel) {
+			mem_heap_t*	bounds_heap = mem_heap_create(1024);
+			std::vector<const dtuple_t*>	bounds;
+
+			row_merge_pscan_bounds(
+				dict_table_get_first_index(old_table),
+				srv_alter_scan_threads * 8, bounds_heap,
+				bounds);
+
+			/* A single-page table is not worth splitting. */
+			if (!bounds.empty()) {
+				err = row_merge_read_clustered_index_parallel(
+					trx, table, old_table, online, index,
+					files, key_numbers, n_index, tmpfd,
+					stage, pct_cost, bounds,
+					srv_alter_scan_threads);
+				mem_heap_free(bounds_heap);
+				trx->op_info = "";
+				DBUG_RETURN(err);
+			}
+
+			mem_heap_free(bounds_heap);
+		}
+	}
+
 #ifdef FTS_INTERNAL_DIAG_PRINT
 	DEBUG_FTS_SORT_PRINT("FTS_SORT: Start Create Index\n");
 #endif
@@ -1773,7 +2464,7 @@ row_merge_read_clustered_index(
 	merge_buf = static_cast<row_merge_buf_t**>(
 		ut_malloc_nokey(n_index * sizeof *merge_buf));
 
-	row_merge_dup_t	clust_dup = {index[0], table, col_map, 0};
+	row_merge_dup_t	clust_dup = {index[0], table, col_map, 0, NULL};
 	dfield_t*	prev_fields;
 	const ulint	n_uniq = dict_index_get_n_unique(index[0]);
 
@@ -2575,7 +3266,7 @@ row_merge_read_clustered_index(
 					}
 				} else if (dict_index_is_unique(buf->index)) {
 					row_merge_dup_t	dup = {
-						buf->index, table, col_map, 0};
+						buf->index, table, col_map, 0, NULL};
 
 					row_merge_buf_sort(buf, &dup);
 
@@ -3313,7 +4004,8 @@ row_merge_sort(
 	pfs_os_file_t*			tmpfd,
 	const bool		update_progress,
 					/*!< in: update progress
-					status variable or not */
+					status variable and report
+					progress to the client, or not */
 	const double 		pct_progress,
 					/*!< in: total progress percent
 					until now */
@@ -3363,7 +4055,7 @@ row_merge_sort(
 	*/
 #ifndef UNIV_SOLARIS
 	/* Progress report only for "normal" indexes. */
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_init(trx->mysql_thd, 1);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3380,7 +4072,7 @@ row_merge_sort(
 		show processlist progress field */
 		/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-		if (!(dup->index->type & DICT_FTS)) {
+		if (update_progress && !(dup->index->type & DICT_FTS)) {
 			thd_progress_report(trx->mysql_thd, file->offset - num_runs, file->offset);
 		}
 #endif /* UNIV_SOLARIS */
@@ -3409,7 +4101,7 @@ row_merge_sort(
 
 	/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_end(trx->mysql_thd);
 	}
 #endif /* UNIV_SOLARIS */
@@ -4526,6 +5218,247 @@ void row_merge_write_redo(const dict_index_t* index)
 	mtr.commit();
 }
 
+/** Shared state of building several secondary indexes concurrently
+after the clustered index has been read. The threads take the indexes
+in turn, and each merge-sorts and bulk loads one index at a time. */
+struct row_merge_pbuild_t
+{
+	/** transaction */
+	trx_t*			trx;
+	/** MySQL table object, for reporting duplicates */
+	struct TABLE*		table;
+	/** the table */
+	const dict_table_t*	old_table;
+	/** indexes to be built */
+	dict_index_t**		index;
+	/** merge files of index[] */
+	merge_file_t**		files;
+	/** progress percent of loading index[] */
+	const double*		pct_cost;
+	/** outcome of building index[] */
+	dberr_t*		err;
+	/** number of indexes to build */
+	ulint			n_index;
+	/** total progress percent before the build */
+	double			pct_progress;
+	/** the next index to build */
+	Atomic_counter<ulint>	next;
+	/** whether building an index failed */
+	std::atomic<bool>	failed;
+	/** the index whose duplicate was copied to table->record[0] */
+	std::atomic<const dict_index_t*>	reported;
+};
+
+/** Thread for building secondary indexes concurrently.
+@param[in,out]	arg	row_merge_pbuild_t
+@return OS_THREAD_DUMMY_RETURN */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_pbuild_thread)(void* arg)
+{
+	row_merge_pbuild_t*	build = static_cast<row_merge_pbuild_t*>(arg);
+	const ulint		space_id = build->old_table->space_id;
+	const size_t		block_size = 3 * srv_sort_buf_size;
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	block = alloc.allocate_large(
+		block_size, &block_pfx);
+	row_merge_block_t*	crypt_block = NULL;
+	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
+
+	if (log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(
+			block_size + WOLFSSL_PAD_SIZE, &crypt_pfx);
+	}
+
+	for (ulint t; !build->failed && (t = build->next++) < build->n_index;
+	     ) {
+		dict_index_t*	index = build->index[t];
+		merge_file_t*	file = build->files[t];
+		dberr_t		err;
+
+		if (!block || (log_tmp_is_encrypted() && !crypt_block)) {
+			err = DB_OUT_OF_MEMORY;
+		} else {
+			row_merge_dup_t	dup = {
+				index, build->table, NULL, 0,
+				&build->reported};
+
+			/* The sort does not report progress. The bulk
+			load below does, through the atomic
+			onlineddl_pct_progress. */
+			err = row_merge_sort(
+				build->trx, &dup, file, block, &tmpfd,
+				false, 0.0, 0.0, crypt_block, space_id);
+		}
+
+		if (err == DB_SUCCESS) {
+			BtrBulk	btr_bulk(index, build->trx,
+					 build->trx->get_flush_observer());
+
+			err = row_merge_insert_index_tuples(
+				index, build->old_table, file->fd, block,
+				NULL, &btr_bulk, file->n_rec,
+				build->pct_progress, build->pct_cost[t],
+				crypt_block, space_id);
+
+			err = btr_bulk.finish(err);
+		}
+
+		/* Close the temporary file to free up space. */
+		row_merge_file_destroy(file);
+
+		build->err[t] = err;
+
+		if (err != DB_SUCCESS) {
+			build->failed = true;
+		}
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block) {
+		alloc.deallocate_large(block, &block_pfx, block_size);
+	}
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx,
+				       block_size + WOLFSSL_PAD_SIZE);
+	}
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Merge-sort and bulk load several secondary indexes concurrently,
+when adding them without rebuilding the table. Each thread allocates
+its own sort buffers, so innodb_alter_build_threads also bounds the
+memory used. The merge files of the built indexes are closed, so that
+row_merge_build_indexes() will skip them. Nothing is done unless there
+are at least two non-empty indexes to build.
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table, for reporting duplicates
+@param[in]	old_table	the table
+@param[in]	indexes		indexes to be created
+@param[in]	key_numbers	MySQL key numbers
+@param[in]	n_indexes	size of indexes[]
+@param[in,out]	merge_files	merge files of the non-spatial indexes
+@param[in,out]	pct_progress	total progress percent until now
+@param[in]	total_cost	total cost of the ALTER TABLE
+@param[in]	total_dynamic_cost	total cost of building the
+indexes that depends on their size
+@param[in]	total_index_blocks	total size of merge_files[]
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_build_indexes_parallel(
+	trx_t*			trx,
+	struct TABLE*		table,
+	const dict_table_t*	old_table,
+	dict_index_t**		indexes,
+	const ulint*		key_numbers,
+	ulint			n_indexes,
+	merge_file_t*		merge_files,
+	double&			pct_progress,
+	double			total_cost,
+	double			total_dynamic_cost,
+	ulint			total_index_blocks)
+{
+	std::vector<dict_index_t*>	index;
+	std::vector<merge_file_t*>	files;
+	std::vector<ulint>		keys;
+	std::vector<double>		pct_cost;
+	double				pct_total = 0;
+
+	for (ulint k = 0, i = 0; i < n_indexes; i++) {
+		if (dict_index_is_spatial(indexes[i])) {
+			continue;
+		}
+
+		merge_file_t*	file = &merge_files[k++];
+
+		if (file->fd == OS_FILE_CLOSED) {
+			continue;
+		}
+
+		const double	cost = (COST_BUILD_INDEX_STATIC
+					+ (total_dynamic_cost * file->offset
+					   / total_index_blocks))
+			/ total_cost * 100;
+
+		index.push_back(indexes[i]);
+		files.push_back(file);
+		keys.push_back(key_numbers[i]);
+		pct_cost.push_back(cost * PCT_COST_INSERT_INDEX);
+		pct_total += cost;
+	}
+
+	if (index.size() < 2) {
+		return(DB_SUCCESS);
+	}
+
+	std::vector<dberr_t>	err(index.size(), DB_SUCCESS);
+	row_merge_pbuild_t	build;
+
+	build.trx = trx;
+	build.table = table;
+	build.old_table = old_table;
+	build.index = &index[0];
+	build.files = &files[0];
+	build.pct_cost = &pct_cost[0];
+	build.err = &err[0];
+	build.n_index = index.size();
+	build.pct_progress = pct_progress;
+	build.next = 0;
+	build.failed = false;
+	build.reported = NULL;
+
+	const ulint	n_threads = std::min<ulint>(
+		srv_alter_build_threads, index.size());
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : Start building "
+				      ULINTPF " indexes in " ULINTPF
+				      " threads", ulint(index.size()),
+				      n_threads);
+	}
+
+	std::vector<os_thread_id_t>	threads(n_threads);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		os_thread_create(row_merge_pbuild_thread, &build,
+				 &threads[i]);
+	}
+
+	for (ulint i = 0; i < n_threads; i++) {
+		os_thread_join(threads[i]);
+	}
+
+	pct_progress += pct_total;
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : End of building "
+				      ULINTPF " indexes",
+				      ulint(index.size()));
+	}
+
+	/* Report the index whose duplicate is in table->record[0];
+	otherwise, the first failure. */
+	const dict_index_t*	reported = build.reported;
+
+	for (ulint t = 0; t < index.size(); t++) {
+		if (err[t] != DB_SUCCESS
+		    && (!reported || index[t] == reported)) {
+			trx->error_key_num = keys[t];
+			return(err[t]);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4677,6 +5610,7 @@ row_merge_build_indexes(
 			dup->table = table;
 			dup->col_map = col_map;
 			dup->n_dup = 0;
+			dup->reported = NULL;
 
 			/* This can fail e.g. if temporal files can't be
 			created */
@@ -4746,6 +5680,25 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	if (srv_alter_build_threads > 1 && old_table == new_table
+	    && !fts_sort_idx) {
+		error = row_merge_build_indexes_parallel(
+			trx, table, old_table, indexes, key_numbers,
+			n_indexes, merge_files, pct_progress,
+			total_static_cost + total_dynamic_cost,
+			total_dynamic_cost, total_index_blocks);
+
+		if (error != DB_SUCCESS) {
+			if (FlushObserver* flush_observer =
+			    trx->get_flush_observer()) {
+				flush_observer->interrupted();
+				flush_observer->flush();
+			}
+
+			goto func_exit;
+		}
+	}
+
 	for (ulint k = 0, i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
@@ -4828,7 +5781,7 @@ row_merge_build_indexes(
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
-				sort_idx, table, col_map, 0};
+				sort_idx, table, col_map, 0, NULL};
 
 			pct_cost = (COST_BUILD_INDEX_STATIC +
 				(total_dynamic_cost * merge_files[k].offset /
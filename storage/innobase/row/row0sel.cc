@@ -1482,8 +1482,7 @@ row_sel_try_search_shortcut(
 	ut_ad(plan->unique_search);
 	ut_ad(!plan->must_get_clust);
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	rw_lock_s_lock(ahi_latch);
+	rw_lock_t* ahi_latch = btr_search_s_lock(btr_get_search_latch(index));
 
 	row_sel_open_pcur(plan, ahi_latch, mtr);
 
@@ -3687,7 +3686,7 @@ row_sel_dequeue_cached_row_for_mysql(
 }
 
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache for prebuilt->fetch_cache_limit rows. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3697,12 +3696,20 @@ row_sel_prefetch_cache_init(
 	ulint	i;
 	ulint	sz;
 	byte*	ptr;
+	const ulint n = prebuilt->fetch_cache_limit;
 
-	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
+	ut_ad(!prebuilt->fetch_cache);
+
+	/* Reserve space for the row pointers and the magic numbers. */
+	sz = n * (sizeof *prebuilt->fetch_cache
+		  + prebuilt->mysql_row_len + 8);
 	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	prebuilt->fetch_cache = reinterpret_cast<byte**>(ptr);
+	prebuilt->fetch_cache_size = n;
+	ptr += n * sizeof *prebuilt->fetch_cache;
+
+	for (i = 0; i < n; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3719,6 +3726,88 @@ row_sel_prefetch_cache_init(
 	}
 }
 
+/** Free the prefetch cache of a prebuilt struct.
+@param[in,out]	prebuilt	prebuilt struct */
+void
+row_sel_prefetch_cache_free(
+	row_prebuilt_t*	prebuilt)
+{
+	if (!prebuilt->fetch_cache) {
+		return;
+	}
+
+	const byte*	ptr = reinterpret_cast<const byte*>(
+		prebuilt->fetch_cache + prebuilt->fetch_cache_size);
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_size; i++) {
+		ulint	magic1 = mach_read_from_4(ptr);
+		ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+
+		ut_a(ptr == prebuilt->fetch_cache[i]);
+		ptr += prebuilt->mysql_row_len;
+
+		ulint	magic2 = mach_read_from_4(ptr);
+		ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+	}
+
+	ut_free(prebuilt->fetch_cache);
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_size = 0;
+}
+
+/** Set the number of rows to prefetch. The cache must be empty.
+@param[in,out]	prebuilt	prebuilt struct
+@param[in]	limit		number of rows to prefetch */
+static
+void
+row_sel_prefetch_cache_set_limit(
+	row_prebuilt_t*	prebuilt,
+	ulint		limit)
+{
+	ut_ad(!prebuilt->n_fetch_cached);
+	ut_ad(limit >= MYSQL_FETCH_CACHE_SIZE);
+
+	prebuilt->fetch_cache_limit = limit;
+
+	if (prebuilt->fetch_cache_size < limit) {
+		/* Reallocate on the next row_sel_fetch_last_buf(). */
+		row_sel_prefetch_cache_free(prebuilt);
+	}
+}
+
+/** Determine the maximum number of rows to prefetch.
+@param[in]	prebuilt	prebuilt struct
+@return the maximum for prebuilt->fetch_cache_limit */
+static
+ulint
+row_sel_prefetch_cache_max(
+	const row_prebuilt_t*	prebuilt)
+{
+	return std::max<ulint>(
+		MYSQL_FETCH_CACHE_SIZE,
+		std::min<ulint>(MYSQL_FETCH_CACHE_MAX_ROWS,
+				MYSQL_FETCH_CACHE_MAX_BYTES
+				/ (prebuilt->mysql_row_len + 8)));
+}
+
+/** Determine the number of rows to prefetch at the start of a scan.
+A scan that was announced by the SQL layer starts at its estimated
+number of rows, but not above row_sel_prefetch_cache_max().
+@param[in]	prebuilt	prebuilt struct
+@return the initial prebuilt->fetch_cache_limit */
+static
+ulint
+row_sel_prefetch_cache_start(
+	const row_prebuilt_t*	prebuilt)
+{
+	return std::max<ulint>(
+		MYSQL_FETCH_CACHE_SIZE,
+		std::min(prebuilt->fetch_cache_scan_rows,
+			 row_sel_prefetch_cache_max(prebuilt)));
+}
+
 /********************************************************************//**
 Get the last fetch cache buffer from the queue.
 @return pointer to buffer. */
@@ -3729,9 +3818,9 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
+	if (prebuilt->fetch_cache == NULL) {
 		/* Allocate memory for the fetch cache */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
@@ -3792,8 +3881,7 @@ row_sel_try_search_shortcut_for_mysql(
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(!prebuilt->templ_contains_blob);
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	rw_lock_s_lock(ahi_latch);
+	rw_lock_t* ahi_latch = btr_search_s_lock(btr_get_search_latch(index));
 	btr_pcur_open_with_no_init(index, search_tuple, PAGE_CUR_GE,
 				   BTR_SEARCH_LEAF, pcur, ahi_latch, mtr);
 	rec = btr_pcur_get_rec(pcur);
@@ -4218,6 +4306,9 @@ row_search_mvcc(
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
 
+		row_sel_prefetch_cache_set_limit(
+			prebuilt, row_sel_prefetch_cache_start(prebuilt));
+
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
 			row_prebuild_sel_graph(prebuilt);
@@ -4252,7 +4343,8 @@ row_search_mvcc(
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_limit) {
 
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -4269,6 +4361,20 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 500000000;
 		}
 
+		if (prebuilt->n_rows_fetched > MYSQL_FETCH_CACHE_THRESHOLD
+		    + MYSQL_FETCH_CACHE_SIZE) {
+			/* The scan went past a full fetch cache. Copy
+			more rows per restoration of the cursor, until
+			the cache is MYSQL_FETCH_CACHE_MAX_BYTES. */
+			const ulint max = row_sel_prefetch_cache_max(prebuilt);
+			if (prebuilt->fetch_cache_limit < max) {
+				row_sel_prefetch_cache_set_limit(
+					prebuilt,
+					std::min(2 * prebuilt
+						 ->fetch_cache_limit, max));
+			}
+		}
+
 		mode = pcur->search_mode;
 	}
 
@@ -5355,7 +5461,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5407,7 +5513,7 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit) {
 			goto next_rec;
 		}
 
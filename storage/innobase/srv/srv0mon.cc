@@ -1092,6 +1092,12 @@ static monitor_info_t	innodb_counter_info[] =
 	 "Number of Adaptive Hash Index rows updated",
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_ROW_UPDATED},
+
+	{"adaptive_hash_build_skipped", "adaptive_hash_index",
+	 "Number of times an Adaptive Hash Index was not built for a page"
+	 " because of innodb_adaptive_hash_index_min_hit_pct",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_BUILD_SKIPPED},
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	/* ========== Counters for tablespace ========== */
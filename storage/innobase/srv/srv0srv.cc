@@ -153,6 +153,10 @@ on duplicate key checking and foreign key checking */
 ibool	srv_locks_unsafe_for_binlog;
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** Number of threads for reading the clustered index in index creation */
+ulong	srv_alter_scan_threads;
+/** Number of secondary indexes to build concurrently in index creation */
+ulong	srv_alter_build_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -193,6 +197,12 @@ ulong		srv_page_size;
 ulong		srv_page_size_shift;
 /** innodb_log_write_ahead_size */
 ulong		srv_log_write_ahead_size;
+/** innodb_log_writer_threads; whether to write and flush the redo log
+in log_writer_thread and log_flusher_thread */
+my_bool		srv_log_writer_threads;
+/** innodb_log_apply_threads; number of threads for applying the redo log
+during crash recovery */
+ulong		srv_n_log_apply_threads;
 
 /** innodb_adaptive_flushing; try to flush dirty pages so as to avoid
 IO bursts at the checkpoints. */
@@ -242,6 +252,10 @@ ulint	srv_buf_pool_base_size;
 ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** Number of threads for loading the buffer pool */
+ulong	srv_buf_pool_load_threads;
+/** Seconds between periodic buffer pool dumps, or 0 */
+ulong	srv_buf_pool_dump_interval;
 /** Abort load after this amount of pages */
 #ifdef UNIV_DEBUG
 ulong srv_buf_pool_load_pages_abort = LONG_MAX;
@@ -282,6 +296,10 @@ ulong	srv_max_io_capacity;
 /** innodb_page_cleaners; the number of page cleaner threads */
 ulong	srv_n_page_cleaners;
 
+/** innodb_lru_flush_threads; whether each buffer pool instance has
+a dedicated LRU flushing thread */
+my_bool	srv_LRU_flush_threads;
+
 /* The InnoDB main thread tries to keep the ratio of modified pages
 in the buffer pool to all database pages in the buffer pool smaller than
 the following number. But it is not guaranteed that the value stays below
@@ -305,6 +323,9 @@ ulong	srv_n_purge_threads;
 
 /** innodb_purge_batch_size, in pages */
 ulong	srv_purge_batch_size;
+/** History list length per purge thread; 0 to adjust the number of
+purge threads by the growth of the history list */
+ulong	srv_purge_history_per_thread;
 
 /** innodb_stats_method decides how InnoDB treats
 NULL value when collecting statistics. By default, it is set to
@@ -375,6 +396,15 @@ number of pages to use in LRU and flush_list batch flushing.
 The rest of the doublewrite buffer is used for single-page flushing. */
 ulong	srv_doublewrite_batch_size = 120;
 
+/** innodb_parallel_doublewrite; whether LRU and flush_list batches are
+written to a doublewrite file of their buffer pool instance, so that
+the batches of different instances can proceed in parallel */
+my_bool	srv_parallel_doublewrite;
+
+/** innodb_parallel_doublewrite_batch_size; the number of pages in each
+batch area of the parallel doublewrite files */
+ulong	srv_parallel_doublewrite_batch_size;
+
 /** innodb_replication_delay */
 ulong	srv_replication_delay;
 
@@ -1310,6 +1340,7 @@ srv_printf_innodb_monitor(
 	      "LOG\n"
 	      "---\n", file);
 	log_print(file);
+	recv_print(file);
 
 	fputs("----------------------\n"
 	      "BUFFER POOL AND MEMORY\n"
@@ -1516,6 +1547,16 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_log_writes = srv_stats.log_writes;
 
+	export_vars.innodb_log_flusher_batches = srv_stats.log_flusher_batches;
+
+	export_vars.innodb_log_flusher_batch_bytes =
+		srv_stats.log_flusher_batch_bytes;
+
+	export_vars.innodb_log_flusher_waits = srv_stats.log_flusher_waits;
+
+	export_vars.innodb_log_flusher_wait_time =
+		srv_stats.log_flusher_wait_time;
+
 	export_vars.innodb_dblwr_pages_written =
 		srv_stats.dblwr_pages_written;
 
@@ -1547,6 +1588,51 @@ srv_export_innodb_status(void)
 	export_vars.innodb_row_lock_time_max =
 		lock_sys.n_lock_max_wait_time / 1000;
 
+	export_vars.innodb_deadlock_detect_cycles =
+		srv_stats.deadlock_detect_cycles;
+
+	if (ulint n = srv_stats.deadlock_detect_cycles) {
+		export_vars.innodb_deadlock_detect_latency_avg = ulint(
+			srv_stats.deadlock_detect_latency / n);
+	} else {
+		export_vars.innodb_deadlock_detect_latency_avg = 0;
+	}
+
+	export_vars.innodb_deadlock_detect_latency_max =
+		lock_sys.n_deadlock_max_latency;
+
+	export_vars.innodb_deadlock_detect_snapshots =
+		srv_stats.deadlock_detect_snapshots;
+
+	export_vars.innodb_deadlock_detect_snapshot_time =
+		srv_stats.deadlock_detect_snapshot_time;
+
+	export_vars.innodb_ft_cache_size = srv_stats.fts_cache_size;
+	export_vars.innodb_ft_sync_stalls = srv_stats.fts_sync_stalls;
+	export_vars.innodb_ft_sync_time = srv_stats.fts_sync_time / 1000;
+	export_vars.innodb_ft_syncs = srv_stats.fts_syncs;
+
+	export_vars.innodb_purge_records = srv_stats.purge_records;
+
+	/* Estimate the history in undo log records by the average
+	number of records per undo log that was purged so far. */
+	if (ulint n = srv_stats.purge_undo_logs) {
+		export_vars.innodb_purge_lag_records = ulint(
+			double(trx_sys.rseg_history_len)
+			* double(srv_stats.purge_records) / double(n));
+	} else {
+		export_vars.innodb_purge_lag_records
+			= trx_sys.rseg_history_len;
+	}
+
+	export_vars.innodb_purge_lag_seconds = purge_sys.lag_seconds;
+	export_vars.innodb_purge_threads_active = purge_sys.n_active_threads;
+
+	export_vars.innodb_read_view_snapshots =
+		srv_stats.read_view_snapshots;
+
+	export_vars.innodb_read_views_reused = srv_stats.read_views_reused;
+
 	export_vars.innodb_rows_read = srv_stats.n_rows_read;
 
 	export_vars.innodb_rows_inserted = srv_stats.n_rows_inserted;
@@ -1579,6 +1665,19 @@ srv_export_innodb_status(void)
 	export_vars.innodb_page_compressed_trim_op = srv_stats.page_compressed_trim_op;
 	export_vars.innodb_pages_page_decompressed = srv_stats.pages_page_decompressed;
 	export_vars.innodb_pages_page_compression_error = srv_stats.pages_page_compression_error;
+
+	for (ulint i = 0; i <= PAGE_ALGORITHM_LAST; i++) {
+		export_vars.innodb_page_compression_pages[i] =
+			srv_stats.page_compression_pages[i];
+		export_vars.innodb_page_compression_bytes[i] =
+			srv_stats.page_compression_bytes[i];
+		export_vars.innodb_page_compression_time[i] =
+			srv_stats.page_compression_time[i] / 1000;
+		export_vars.innodb_page_decompression_pages[i] =
+			srv_stats.page_decompression_pages[i];
+		export_vars.innodb_page_decompression_time[i] =
+			srv_stats.page_decompression_time[i] / 1000;
+	}
 	export_vars.innodb_pages_decrypted = srv_stats.pages_decrypted;
 	export_vars.innodb_pages_encrypted = srv_stats.pages_encrypted;
 	export_vars.innodb_n_merge_blocks_encrypted = srv_stats.n_merge_blocks_encrypted;
@@ -1611,6 +1710,8 @@ srv_export_innodb_status(void)
 		crypt_stat.pages_flushed;
 	export_vars.innodb_encryption_rotation_estimated_iops =
 		crypt_stat.estimated_iops;
+	export_vars.innodb_encryption_rotation_threads_joined =
+		crypt_stat.threads_joined;
 	export_vars.innodb_encryption_key_requests =
 		srv_stats.n_key_requests;
 	export_vars.innodb_key_rotation_list_length =
@@ -2554,7 +2655,13 @@ srv_do_purge(ulint* n_total_purged)
 	}
 
 	do {
-		if (trx_sys.rseg_history_len > rseg_history_len
+		if (const ulong per_thread = srv_purge_history_per_thread) {
+			/* Use one more thread for each per_thread
+			entries of the history list. */
+			n_use_threads = std::min<ulint>(
+				n_threads,
+				1 + trx_sys.rseg_history_len / per_thread);
+		} else if (trx_sys.rseg_history_len > rseg_history_len
 		    || (srv_max_purge_lag > 0
 			&& rseg_history_len > srv_max_purge_lag)) {
 
@@ -2582,6 +2689,8 @@ srv_do_purge(ulint* n_total_purged)
 		ut_a(n_use_threads > 0);
 		ut_a(n_use_threads <= n_threads);
 
+		purge_sys.update_lag();
+
 		/* Take a snapshot of the history list before purge. */
 		if (!(rseg_history_len = trx_sys.rseg_history_len)) {
 			break;
@@ -504,6 +504,7 @@ create_log_files(
 
 	log_sys.buf_free = LOG_BLOCK_HDR_SIZE;
 	log_sys.lsn += LOG_BLOCK_HDR_SIZE;
+	log_sys.buf_ready_lsn = log_sys.lsn;
 
 	MONITOR_SET(MONITOR_LSN_CHECKPOINT_AGE,
 		    (log_sys.lsn - log_sys.last_checkpoint_lsn));
@@ -1101,6 +1102,14 @@ srv_shutdown_all_bg_threads()
 			if (log_scrub_thread_active) {
 				os_event_set(log_scrub_event);
 			}
+
+			if (log_writer_thread_active) {
+				os_event_set(log_sys.writer_event);
+			}
+
+			if (log_flusher_thread_active) {
+				os_event_set(log_sys.flusher_event);
+			}
 		}
 
 		if (srv_start_state_is_set(SRV_START_STATE_IO)) {
@@ -2282,6 +2291,10 @@ dberr_t srv_start(bool create_new_db)
 
 		trx_temp_rseg_create();
 
+		if (srv_log_writer_threads) {
+			log_writer_threads_start();
+		}
+
 		if (srv_force_recovery < SRV_FORCE_NO_BACKGROUND) {
 			thread_handles[1 + SRV_MAX_N_IO_THREADS]
 				= os_thread_create(srv_master_thread, NULL,
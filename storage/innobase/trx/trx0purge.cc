@@ -175,6 +175,10 @@ void purge_sys_t::create()
   mutex_create(LATCH_ID_PURGE_SYS_PQ, &pq_mutex);
   truncate.current= NULL;
   truncate.last= NULL;
+  heap= mem_heap_create(4096);
+  n_lag_samples= 0;
+  lag_seconds= 0;
+  n_active_threads= 0;
 }
 
 /** Close the purge subsystem on shutdown. */
@@ -193,6 +197,7 @@ void purge_sys_t::close()
   trx_free(trx);
   rw_lock_free(&latch);
   mutex_free(&pq_mutex);
+  mem_heap_free(heap);
   os_event_destroy(event);
 }
 
@@ -851,6 +856,7 @@ static void trx_purge_rseg_get_next_history_log(
 	/* Increase the purge page count by one for every handled log */
 
 	(*n_pages_handled)++;
+	srv_stats.purge_undo_logs.inc();
 
 	prev_log_addr = trx_purge_get_log_from_hist(
 		flst_get_prev_addr(log_hdr + TRX_UNDO_HISTORY_NODE, &mtr));
@@ -1100,6 +1106,89 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/** An undo log record of a purge batch, with the key by which
+trx_purge_attach_undo_recs() distributes the records to the purge threads */
+struct trx_purge_batch_rec_t
+{
+	/** the record to purge */
+	trx_purge_rec_t	rec;
+	/** the table of the record, or 0 for the dummy record */
+	table_id_t	table_id;
+	/** the first PRIMARY KEY field of the record, or NULL */
+	const byte*	key;
+	/** length of key */
+	ulint		key_len;
+	/** position of the record in the batch */
+	ulint		pos;
+
+	/** Read table_id and key from the undo log record. */
+	void parse()
+	{
+		table_id = 0;
+		key = NULL;
+		key_len = 0;
+
+		if (rec.undo_rec == &trx_purge_dummy_rec) {
+			return;
+		}
+
+		ulint		type;
+		ulint		cmpl_info;
+		bool		updated_extern;
+		undo_no_t	undo_no;
+		const byte*	ptr = trx_undo_rec_get_pars(
+			rec.undo_rec, &type, &cmpl_info,
+			&updated_extern, &undo_no, &table_id);
+
+		switch (type) {
+		case TRX_UNDO_UPD_EXIST_REC:
+		case TRX_UNDO_UPD_DEL_REC:
+		case TRX_UNDO_DEL_MARK_REC:
+			trx_id_t	trx_id;
+			roll_ptr_t	roll_ptr;
+			ulint		info_bits;
+			ptr = trx_undo_update_rec_get_sys_cols(
+				ptr, &trx_id, &roll_ptr, &info_bits);
+			/* fall through */
+		case TRX_UNDO_INSERT_REC:
+			ulint		len;
+			ulint		orig_len;
+			trx_undo_rec_get_col_val(ptr, &key, &len, &orig_len);
+			if (len < UNIV_EXTERN_STORAGE_FIELD) {
+				key_len = len;
+			} else {
+				key = NULL;
+			}
+		}
+	}
+
+	/** Compare the keys of two records.
+	@param[in]	other	another record
+	@return negative, 0 or positive if this record is ordered
+	before, together with or after other */
+	int cmp(const trx_purge_batch_rec_t& other) const
+	{
+		if (table_id != other.table_id) {
+			return table_id < other.table_id ? -1 : 1;
+		}
+
+		if (ulint len = std::min(key_len, other.key_len)) {
+			if (int c = memcmp(key, other.key, len)) {
+				return c;
+			}
+		}
+
+		return int(key_len) - int(other.key_len);
+	}
+
+	/** Order the records by key, and then by position in the batch. */
+	bool operator<(const trx_purge_batch_rec_t& other) const
+	{
+		int c = cmp(other);
+		return c < 0 || (!c && pos < other.pos);
+	}
+};
+
 /** Run a purge batch.
 @param n_purge_threads	number of purge threads
 @return number of undo log pages handled in the batch */
@@ -1139,29 +1228,15 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 	ut_ad(i == n_purge_threads);
 #endif
 
-	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
-
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
-	i = 0;
-
 	const ulint batch_size = srv_purge_batch_size;
+	std::vector<trx_purge_batch_rec_t>	recs;
 
+	/* Fetch the whole batch of UNDO records. They will be parsed
+	by the purge threads in row_purge_parse_undo_rec(). */
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+		trx_purge_batch_rec_t	purge_rec;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1171,40 +1246,73 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 		}
 
 		/* Fetch the next record, and advance the purge_sys.tail. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
+		purge_rec.rec.undo_rec = trx_purge_fetch_next_rec(
+			&purge_rec.rec.roll_ptr, &n_pages_handled,
+			purge_sys.heap);
 
-		if (purge_rec->undo_rec != NULL) {
+		if (purge_rec.rec.undo_rec == NULL) {
+			break;
+		}
 
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		purge_rec.pos = recs.size();
+		purge_rec.parse();
+		recs.push_back(purge_rec);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		if (n_pages_handled >= batch_size) {
+			break;
+		}
+	}
 
-			if (n_pages_handled >= batch_size) {
+	ut_ad(purge_sys.head <= purge_sys.tail);
 
-				break;
-			}
-		} else {
-			break;
+	srv_stats.purge_records.add(recs.size());
+
+	/* Assign each purge thread a contiguous range of tables and
+	PRIMARY KEY values, instead of dealing the records round-robin.
+	This lets the threads work on different index pages, and keeps
+	all records of a row in one thread, in the order of the history. */
+	std::sort(recs.begin(), recs.end());
+
+	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
+	ut_a(n_thrs > 0 && thr != NULL);
+
+	const ulint n_recs = recs.size();
+	ulint first = 0;
+
+	for (i = 0; i < n_purge_threads && first < n_recs; i++) {
+		ulint	last = i + 1 == n_purge_threads
+			? n_recs
+			: std::max(first, n_recs * (i + 1) / n_purge_threads);
+
+		while (last > first && last < n_recs
+		       && !recs[last - 1].cmp(recs[last])) {
+			last++;
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		if (last > first) {
+			purge_node_t*	node = static_cast<purge_node_t*>(
+				thr->child);
+			ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
+			ut_a(!thr->is_active);
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t), last - first);
+
+			/* The purge threads pop the records from the end
+			of the vector. */
+			for (ulint j = last; j-- > first; ) {
+				ib_vector_push(node->undo_recs, &recs[j].rec);
+			}
+
+			first = last;
 		}
 
-		ut_a(thr != NULL);
+		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ut_a(thr != NULL || i + 1 == n_purge_threads);
 	}
 
-	ut_ad(purge_sys.head <= purge_sys.tail);
+	ut_ad(first == n_recs);
 
 	return(n_pages_handled);
 }
@@ -1301,6 +1409,7 @@ trx_purge(
 
 	/* Fetch the UNDO recs that need to be purged. */
 	n_pages_handled = trx_purge_attach_undo_recs(n_purge_threads);
+	purge_sys.n_active_threads = n_purge_threads;
 	purge_sys.n_tasks.store(n_purge_threads - 1, std::memory_order_relaxed);
 
 	/* Submit tasks to workers queue if using multi-threaded purge. */
@@ -1318,6 +1427,8 @@ trx_purge(
 
 	ut_ad(purge_sys.n_tasks.load(std::memory_order_relaxed) == 0);
 
+	mem_heap_empty(purge_sys.heap);
+
 	if (truncate) {
 		trx_purge_truncate_history();
 	}
@@ -1328,6 +1439,44 @@ trx_purge(
 	return(n_pages_handled);
 }
 
+/** Sample the transaction commit number and update lag_seconds.
+Invoked by the srv_purge_coordinator_thread. */
+void purge_sys_t::update_lag()
+{
+	const time_t	now = time(NULL);
+
+	if (!n_lag_samples
+	    || lag_samples[(n_lag_samples - 1) % N_LAG_SAMPLES].time != now) {
+		lag_sample_t&	s = lag_samples[n_lag_samples++
+						% N_LAG_SAMPLES];
+		s.trx_no = trx_sys.get_max_trx_id();
+		s.time = now;
+	}
+
+	if (!trx_sys.rseg_history_len) {
+		lag_seconds = 0;
+		return;
+	}
+
+	/* The oldest unpurged transaction was committed after the
+	latest sample whose trx_no does not exceed tail.trx_no(),
+	and before the oldest sample whose trx_no does. */
+	const trx_id_t	tail_no = tail.trx_no();
+	time_t		since = now;
+
+	for (ulint i = n_lag_samples,
+		     n = std::min(n_lag_samples, ulint(N_LAG_SAMPLES));
+	     n--; ) {
+		const lag_sample_t& s = lag_samples[--i % N_LAG_SAMPLES];
+		if (s.trx_no <= tail_no) {
+			break;
+		}
+		since = s.time;
+	}
+
+	lag_seconds = ulint(now - since);
+}
+
 /** Stop purge during FLUSH TABLES FOR EXPORT */
 void purge_sys_t::stop()
 {